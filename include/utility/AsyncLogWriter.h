@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LockFreeQueue.h"
+#include "Logger.h"
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief The backend of the asynchronous logging mode.
+	 * @details Producers push records into a bounded lock-free queue; a dedicated writer thread drains it in batches and hands each batch to the sinks of `Logger` (see `Logger::writeToSinks`). The destructor drains every queued record before joining the writer thread.
+	 */
+	class AsyncLogWriter {
+		utility::BoundedQueue<LogRecord> m_Queue;
+		const AsyncLoggerOptions m_Options;
+
+		// the position in the queue before which every record has been either written or dropped (see `pass`)
+		alignas(utility::CACHE_LINE_SIZE) std::atomic<size_t> m_Passed{ 0 };
+		std::atomic<size_t> m_Dropped{ 0 };
+
+		// used to put the writer thread to sleep while the queue is empty
+		alignas(utility::CACHE_LINE_SIZE) std::atomic<uint32_t> m_Signal{ 0 };
+		std::atomic<bool> m_Sleeping{ false };
+		std::atomic<bool> m_Stop{ false };
+
+		std::thread m_Thread;
+
+		void run();
+		void writeBatch(const std::vector<LogRecord>&);
+		void wake(bool force = false);
+		void pass();
+
+	public:
+
+		explicit AsyncLogWriter(const AsyncLoggerOptions& = {});
+		AsyncLogWriter(const AsyncLogWriter&) = delete;
+		AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+		~AsyncLogWriter();
+
+		void push(LogRecord&&);
+		void flush();
+
+		/**
+		 * @return The number of records discarded because the queue was full.
+		 */
+		size_t droppedCount() const {
+			return m_Dropped.load(std::memory_order_relaxed);
+		}
+
+	};
+
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Logger.h"
+
+/**
+ * @brief Logs a message in binary form, deferring its formatting to `utility-logdecode`.
+ * @details The callsite (level, format string and source location) is registered the first time the statement executes; afterwards, each execution only copies the callsite ID, a timestamp and the raw bytes of the arguments into a thread-local buffer.
+ * @param level The name of a `LOG_LEVEL` enumerator (e.g., `LL_INFO`).
+ * @param format A string literal in `fmt` syntax.
+ */
+#define UTILITY_BINARY_LOG(level, format, ...) \
+	do { \
+		static const uint32_t utilityBinaryCallsiteId = ::m0st4fa::BinaryLogger::registerCallsite(::m0st4fa::LOG_LEVEL::level, format); \
+		if (::m0st4fa::BinaryLogger::isEnabled(::m0st4fa::LOG_LEVEL::level)) \
+			::m0st4fa::BinaryLogger::log(utilityBinaryCallsiteId __VA_OPT__(,) __VA_ARGS__); \
+	} while (0)
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief The type tags of the arguments stored in a binary log.
+	 */
+	enum class BINARY_ARG_TYPE : uint8_t {
+		BA_BOOL,
+		BA_CHAR,
+		BA_INT64,
+		BA_UINT64,
+		BA_DOUBLE,
+		BA_STRING,
+		BA_POINTER,
+		BA_COUNT
+	};
+
+	/**
+	 * @brief The kinds of records stored in a binary log.
+	 * @details A binary log starts with `BinaryLogger::MAGIC`, followed by records, each starting with one of these tags:
+	 * - `BR_CALLSITE`: `uint32 id`, `uint8 level`, `uint32 line`, `uint32 column`, then the file name, function name and format string, each as `uint32 length` followed by the characters.
+	 * - `BR_MESSAGE`: `uint32 id`, `int64 timestamp` (nanoseconds since the epoch), `uint8 argCount`, then each argument as a `BINARY_ARG_TYPE` tag followed by its raw bytes (strings as `uint32 length` followed by the characters).
+	 * @note Integers are stored in the native byte order; logs must be decoded on a machine with the same byte order.
+	 */
+	enum class BINARY_RECORD_TYPE : uint8_t {
+		BR_CALLSITE = 'C',
+		BR_MESSAGE = 'M',
+	};
+
+	/**
+	 * @brief A registered binary logging callsite.
+	 */
+	struct BinaryCallsite {
+		uint32_t id = 0;
+		LOG_LEVEL level = LOG_LEVEL::LL_INFO;
+		uint32_t line = 0;
+		uint32_t column = 0;
+		std::string fileName{};
+		std::string functionName{};
+		std::string format{};
+	};
+
+	/**
+	 * @brief A logger that writes compact binary records instead of text.
+	 * @details Every thread appends records to its own buffer, which is written to the log file only when full or on `flush`. The text is reconstructed offline by `BinaryLogDecoder` (or the `utility-logdecode` tool). Use it through `UTILITY_BINARY_LOG`.
+	 */
+	class BinaryLogger {
+
+		static inline std::atomic<bool> s_Open{ false };
+
+		// helpers used to encode arguments
+
+		template <typename T>
+		static constexpr BINARY_ARG_TYPE getArgType() {
+			using U = std::remove_cvref_t<T>;
+
+			if constexpr (std::is_same_v<U, bool>)
+				return BINARY_ARG_TYPE::BA_BOOL;
+			else if constexpr (std::is_same_v<U, char>)
+				return BINARY_ARG_TYPE::BA_CHAR;
+			else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+				return BINARY_ARG_TYPE::BA_INT64;
+			else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+				return BINARY_ARG_TYPE::BA_UINT64;
+			else if constexpr (std::is_floating_point_v<U>)
+				return BINARY_ARG_TYPE::BA_DOUBLE;
+			else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+				return BINARY_ARG_TYPE::BA_STRING;
+			else if constexpr (std::is_pointer_v<U>)
+				return BINARY_ARG_TYPE::BA_POINTER;
+			else
+				static_assert(std::is_pointer_v<U>, "Unsupported binary log argument type.");
+		}
+
+		template <typename T>
+		static size_t getEncodedSize(const T& arg) {
+			constexpr BINARY_ARG_TYPE type = getArgType<T>();
+
+			if constexpr (type == BINARY_ARG_TYPE::BA_STRING)
+				return 1 + sizeof(uint32_t) + std::string_view(arg).size();
+			else if constexpr (type == BINARY_ARG_TYPE::BA_BOOL || type == BINARY_ARG_TYPE::BA_CHAR)
+				return 1 + 1;
+			else
+				return 1 + 8;
+		}
+
+		template <typename T>
+		static char* encode(char* out, const T& arg) {
+			constexpr BINARY_ARG_TYPE type = getArgType<T>();
+
+			*out++ = (char)type;
+
+			if constexpr (type == BINARY_ARG_TYPE::BA_STRING) {
+				const std::string_view str{ arg };
+				const uint32_t size = (uint32_t)str.size();
+
+				std::memcpy(out, &size, sizeof(size));
+				std::memcpy(out + sizeof(size), str.data(), size);
+
+				return out + sizeof(size) + size;
+			}
+			else if constexpr (type == BINARY_ARG_TYPE::BA_BOOL || type == BINARY_ARG_TYPE::BA_CHAR) {
+				*out = (char)arg;
+				return out + 1;
+			}
+			else {
+				if constexpr (type == BINARY_ARG_TYPE::BA_INT64) {
+					const int64_t value = (int64_t)arg;
+					std::memcpy(out, &value, 8);
+				}
+				else if constexpr (type == BINARY_ARG_TYPE::BA_UINT64) {
+					const uint64_t value = (uint64_t)arg;
+					std::memcpy(out, &value, 8);
+				}
+				else if constexpr (type == BINARY_ARG_TYPE::BA_DOUBLE) {
+					const double value = (double)arg;
+					std::memcpy(out, &value, 8);
+				}
+				else {
+					const uint64_t value = (uint64_t)(uintptr_t)arg;
+					std::memcpy(out, &value, 8);
+				}
+
+				return out + 8;
+			}
+		}
+
+		static char* reserve(size_t);
+		static void commit(char*);
+		static int64_t getTimestamp();
+
+	public:
+
+		/**
+		 * @brief The first bytes of every binary log.
+		 */
+		static constexpr char MAGIC[8] = { 'U', 'T', 'L', 'B', 'L', 'O', 'G', '1' };
+
+		static bool open(const std::string& path);
+		static void close();
+		static void flush();
+
+		/**
+		 * @return `true` if a log file is open; `false` otherwise.
+		 */
+		static bool isOpen() {
+			return s_Open.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return `true` if messages of `level` are currently recorded; `false` otherwise.
+		 */
+		static bool isEnabled(LOG_LEVEL level) {
+			return isOpen() && Logger::isEnabled(level);
+		}
+
+		static uint32_t registerCallsite(LOG_LEVEL, const char*, std::source_location = std::source_location::current());
+
+		/**
+		 * @brief Records a message of the callsite `id`.
+		 * @details Only the ID, a timestamp and the arguments are copied; nothing is formatted.
+		 * @param[in] id The ID returned by `registerCallsite`.
+		 * @param[in] args The arguments of the message: arithmetic values, pointers and strings.
+		 */
+		template <typename... Args>
+		static void log(uint32_t id, const Args&... args) {
+			static_assert(sizeof...(Args) < 256, "Too many binary log arguments.");
+
+			const size_t size = 1 + sizeof(uint32_t) + sizeof(int64_t) + 1 + (size_t{ 0 } + ... + getEncodedSize(args));
+			const int64_t timestamp = getTimestamp();
+
+			char* out = reserve(size);
+
+			if (!out)
+				return;
+
+			*out++ = (char)BINARY_RECORD_TYPE::BR_MESSAGE;
+			std::memcpy(out, &id, sizeof(id));
+			out += sizeof(id);
+			std::memcpy(out, &timestamp, sizeof(timestamp));
+			out += sizeof(timestamp);
+			*out++ = (char)sizeof...(Args);
+
+			((out = encode(out, args)), ...);
+
+			commit(out);
+		}
+
+	};
+
+	/**
+	 * @brief Options controlling the text produced by `BinaryLogDecoder`.
+	 */
+	struct BinaryLogDecoderOptions {
+		bool color = false;			///< Decorate messages with ANSI colors, exactly like `Logger`.
+		bool timestamps = false;	///< Prefix each message with its timestamp.
+		bool locations = false;		///< Append the source location of each message.
+	};
+
+	/**
+	 * @brief Turns a binary log back into the text `Logger` would have written.
+	 */
+	class BinaryLogDecoder {
+		std::unordered_map<uint32_t, BinaryCallsite> m_Callsites;
+
+	public:
+
+		size_t decode(std::istream&, std::ostream&, const BinaryLogDecoderOptions& = {});
+
+		/**
+		 * @return The callsites found in the decoded log.
+		 */
+		const std::unordered_map<uint32_t, BinaryCallsite>& getCallsites() const {
+			return m_Callsites;
+		}
+
+	};
+
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "NumberParse.h"
+#include "MappedFile.h"
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The configuration of `parseIntegers`.
+	 */
+	struct BulkParseOptions {
+		char delimiter = ',';				///< The character between two fields (any but a digit, a sign or, outside base 10, a hexadecimal letter).
+		int base = 10;						///< 2, 8, 10 or 16.
+		bool skipWhitespace = true;			///< Whether spaces, tabs and line breaks (other than the delimiter) around a field are ignored.
+		size_t threadCount = 0;				///< The maximum number of threads, including the calling one (0 uses `std::thread::hardware_concurrency`).
+		size_t minChunkSize = 1 << 20;		///< The minimum number of characters parsed by each thread.
+	};
+
+	/**
+	 * @brief A field that `parseIntegers` could not parse.
+	 */
+	struct FieldError {
+		size_t offset;			///< The offset of the field within the text.
+		size_t index;			///< The index of the field, which is also its index among the output values.
+		PARSE_ERROR error;
+	};
+
+	/**
+	 * @brief The result of `parseIntegers` into a span.
+	 */
+	struct BulkParseResult {
+		size_t count = 0;		///< The number of fields parsed, which is the number of values written.
+		size_t consumed = 0;	///< The number of characters parsed; less than the size of the text if the span was filled before its end.
+	};
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Checks whether `c` is skipped around fields (see `BulkParseOptions::skipWhitespace`).
+	 */
+	constexpr bool isFieldWhitespace(char c, char delimiter) {
+		return c != delimiter && (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+	}
+
+	/**
+	 * @brief Parses the delimited integers of `text` into `out` until either is exhausted, in a single pass and without allocating (but for errors).
+	 * @details An empty text, or whitespace after the last delimiter, holds no field. A field that is empty or holds more than an integer is reported in `errors`, and its value is 0.
+	 * @tparam T The type of the integers.
+	 * @param[in] text The delimited integers.
+	 * @param[out] out Where to write the values.
+	 * @param[out] errors Where to append the fields that could not be parsed. Their offsets are relative to `text`, plus `offset`.
+	 * @param[in] options The delimiter, base and whitespace handling.
+	 * @param[in] offset The offset of `text`, when it is a part of a larger text; also added to the indices of the errors (through `firstIndex`).
+	 * @param[in] firstIndex The index of the first field of `text` within the larger text.
+	 * @return The number of values written and of characters parsed.
+	 */
+	template <typename T>
+	BulkParseResult parseIntegerChunk(std::string_view text, std::span<T> out, std::vector<FieldError>& errors, const BulkParseOptions& options, size_t offset = 0, size_t firstIndex = 0) {
+		const char* const begin = text.data();
+		const char* const end = begin + text.size();
+		const char* p = begin;
+		size_t count = 0;
+
+		while (count < out.size()) {
+			if (options.skipWhitespace)
+				while (p < end && isFieldWhitespace(*p, options.delimiter))
+					p++;
+
+			// the end of the text, or nothing but whitespace after the last delimiter
+			if (p == end)
+				break;
+
+			const char* const field = p;
+			const ParseResult<T> result = parseInteger<T>(std::string_view{ p, size_t(end - p) }, options.base);
+			PARSE_ERROR error = result.error;
+
+			p += result.consumed;
+
+			if (options.skipWhitespace)
+				while (p < end && isFieldWhitespace(*p, options.delimiter))
+					p++;
+
+			// anything but the delimiter after the integer
+			if (p < end && *p != options.delimiter) {
+				if (error == PARSE_ERROR::PE_NONE)
+					error = PARSE_ERROR::PE_INVALID_FIELD;
+
+				const void* delimiter = std::memchr(p, options.delimiter, size_t(end - p));
+				p = delimiter ? static_cast<const char*>(delimiter) : end;
+			}
+
+			out[count] = error == PARSE_ERROR::PE_NONE ? result.value : T(0);
+
+			if (error != PARSE_ERROR::PE_NONE)
+				errors.push_back({ offset + size_t(field - begin), firstIndex + count, error });
+
+			count++;
+
+			if (p == end)
+				break;
+
+			// past the delimiter
+			p++;
+		}
+
+		return { count, size_t(p - begin) };
+	}
+
+	/**
+	 * @brief Splits a text into `chunkCount` chunks of (nearly) equal sizes, moving each bound past the next delimiter so that no field is split.
+	 * @return The bounds of the chunks; fewer than `chunkCount + 1` if some chunks held no delimiter and were merged.
+	 */
+	inline std::vector<size_t> splitAtDelimiters(std::string_view text, size_t chunkCount, char delimiter) {
+		std::vector<size_t> bounds{ 0 };
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+			const size_t bound = std::max(text.size() * chunk / chunkCount, bounds.back());
+			const size_t next = text.find(delimiter, bound);
+
+			if (next == std::string_view::npos)
+				break;
+
+			bounds.push_back(next + 1);
+		}
+
+		if (bounds.size() == 1 || bounds.back() != text.size())
+			bounds.push_back(text.size());
+
+		return bounds;
+	}
+
+	/**
+	 * @brief Parses the chunks of a text (see `splitAtDelimiters`) on separate threads, each into its own values and errors. The first chunk is parsed on the calling thread.
+	 * @details Each chunk is sized by counting its delimiters, so that it is parsed in one call to `parseIntegerChunk`. The offsets of the errors are relative to the whole text; their indices, to the chunk.
+	 */
+	template <typename T>
+	void parseIntegerChunks(std::string_view text, const std::vector<size_t>& bounds, std::vector<std::vector<T>>& values, std::vector<std::vector<FieldError>>& errors, const BulkParseOptions& options) {
+		const size_t chunkCount = bounds.size() - 1;
+
+		values.resize(chunkCount);
+		errors.resize(chunkCount);
+
+		auto parse = [&](size_t chunk) {
+			const std::string_view part = text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+
+			values[chunk].resize((size_t)std::ranges::count(part, options.delimiter) + 1);
+			values[chunk].resize(parseIntegerChunk<T>(part, values[chunk], errors[chunk], options, bounds[chunk]).count);
+			};
+
+		std::vector<std::thread> threads;
+		threads.reserve(chunkCount - 1);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++)
+			threads.emplace_back(parse, chunk);
+
+		parse(0);
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	/**
+	 * @brief Decides how many chunks a text of `size` characters is split into (see `BulkParseOptions`).
+	 */
+	inline size_t getParseChunkCount(size_t size, const BulkParseOptions& options) {
+		const size_t threadCount = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+		return std::clamp<size_t>(size / std::max<size_t>(options.minChunkSize, 1), 1, threadCount);
+	}
+
+	/**
+	 * @brief Parses the integers of a delimited text (such as a CSV line or a file of one integer per line) into a span.
+	 * @details Large texts are split between delimiters and parsed on several threads (see `BulkParseOptions`). Nothing is thrown for malformed fields: each is reported in `errors`, by offset and index, and its value is 0.
+	 * @tparam T The type of the integers.
+	 * @param[in] text The delimited integers.
+	 * @param[out] out Where to write the values.
+	 * @param[out] errors Where to append the fields that could not be parsed.
+	 * @param[in] options The delimiter, base, whitespace handling and threading.
+	 * @return The number of values written and of characters parsed. If `out` is too small, parsing stops when it is filled.
+	 */
+	template <typename T>
+	BulkParseResult parseIntegers(std::string_view text, std::span<T> out, std::vector<FieldError>& errors, const BulkParseOptions& options = {}) {
+		const size_t chunkCount = getParseChunkCount(text.size(), options);
+
+		if (chunkCount == 1)
+			return parseIntegerChunk(text, out, errors, options);
+
+		const std::vector<size_t> bounds = splitAtDelimiters(text, chunkCount, options.delimiter);
+
+		std::vector<std::vector<T>> chunkValues;
+		std::vector<std::vector<FieldError>> chunkErrors;
+		parseIntegerChunks(text, bounds, chunkValues, chunkErrors, options);
+
+		size_t count = 0;
+
+		for (size_t chunk = 0; chunk + 1 < bounds.size(); chunk++) {
+			// the rest of the span is too small for the chunk: parse what fits again
+			if (chunkValues[chunk].size() > out.size() - count) {
+				const std::string_view rest = text.substr(bounds[chunk]);
+				const BulkParseResult result = parseIntegerChunk(rest, out.subspan(count), errors, options, bounds[chunk], count);
+
+				return { count + result.count, bounds[chunk] + result.consumed };
+			}
+
+			std::ranges::copy(chunkValues[chunk], out.begin() + count);
+
+			for (FieldError error : chunkErrors[chunk]) {
+				error.index += count;
+				errors.push_back(error);
+			}
+
+			count += chunkValues[chunk].size();
+		}
+
+		return { count, text.size() };
+	}
+
+	/**
+	 * @brief Parses all the integers of a delimited text (see `parseIntegers` into a span).
+	 * @return The values, one per field.
+	 */
+	template <typename T>
+	std::vector<T> parseIntegers(std::string_view text, std::vector<FieldError>& errors, const BulkParseOptions& options = {}) {
+		const std::vector<size_t> bounds = splitAtDelimiters(text, getParseChunkCount(text.size(), options), options.delimiter);
+
+		std::vector<std::vector<T>> chunkValues;
+		std::vector<std::vector<FieldError>> chunkErrors;
+		parseIntegerChunks(text, bounds, chunkValues, chunkErrors, options);
+
+		// the values of a single chunk need no copy
+		if (chunkValues.size() == 1) {
+			errors.insert(errors.end(), chunkErrors[0].begin(), chunkErrors[0].end());
+			return std::move(chunkValues[0]);
+		}
+
+		size_t size = 0;
+
+		for (const std::vector<T>& values : chunkValues)
+			size += values.size();
+
+		std::vector<T> result;
+		result.reserve(size);
+
+		for (size_t chunk = 0; chunk < chunkValues.size(); chunk++) {
+			for (FieldError error : chunkErrors[chunk]) {
+				error.index += result.size();
+				errors.push_back(error);
+			}
+
+			result.insert(result.end(), chunkValues[chunk].begin(), chunkValues[chunk].end());
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Parses all the integers of a delimited file, mapped into memory (see `parseIntegers` into a span).
+	 * @return The values, one per field.
+	 */
+	template <typename T>
+	std::vector<T> parseIntegers(const MappedFile& file, std::vector<FieldError>& errors, const BulkParseOptions& options = {}) {
+		return parseIntegers<T>(file.view(), errors, options);
+	}
+
+}
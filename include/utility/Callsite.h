@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Logs a message through a statically registered callsite, which can be switched off at runtime.
+ * @details The callsite registers itself with `CallsiteRegistry` the first time the statement executes. Afterwards, a disabled callsite costs two relaxed loads and neither evaluates nor formats its arguments, unless the `FlightRecorder` is enabled, which keeps its messages as it does those of disabled levels.
+ * @param level The name of a `LOG_LEVEL` enumerator (e.g., `LL_DEBUG`).
+ * @param format A string literal in `fmt` syntax.
+ */
+#define UTILITY_LOG(level, format, ...) \
+	do { \
+		static ::m0st4fa::Callsite& utilityCallsite = ::m0st4fa::CallsiteRegistry::registerCallsite(::m0st4fa::LOG_LEVEL::level); \
+		if (utilityCallsite.isEnabled() || ::m0st4fa::FlightRecorder::isEnabled()) \
+			::m0st4fa::Logger{}.log<::m0st4fa::LOG_LEVEL::level>(utilityCallsite, format __VA_OPT__(,) __VA_ARGS__); \
+	} while (0)
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	enum class LOG_LEVEL;
+
+	/**
+	 * @brief The static descriptor of a logging callsite.
+	 */
+	struct Callsite {
+		size_t id = 0;
+		LOG_LEVEL level{};
+		std::source_location location{};
+		std::string renderedLocation{};			///< The location as appended to traced messages, rendered once.
+		std::atomic<bool> enabled{ true };
+
+		/**
+		 * @return `true` if the callsite logs; `false` if it has been switched off.
+		 */
+		bool isEnabled() const {
+			return enabled.load(std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * @brief The registry of every logging callsite, allowing them to be listed and switched on or off at runtime.
+	 * @details Switching a file or a function also applies to callsites that have not executed (hence registered) yet.
+	 */
+	class CallsiteRegistry {
+	public:
+
+		static Callsite& registerCallsite(LOG_LEVEL, std::source_location = std::source_location::current());
+		static std::vector<const Callsite*> getCallsites();
+
+		static bool setEnabled(size_t, bool);
+		static size_t setFileEnabled(std::string_view, bool);
+		static size_t setFunctionEnabled(std::string_view, bool);
+		static size_t setAllEnabled(bool);
+
+	};
+
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <vector>
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Checks whether a cell of a 2D table holds a value: a non-empty range (e.g. the target states of a transition), or any other value that converts to `true`.
+	 * @tparam E The type of the cell.
+	 * @param[in] cell The cell.
+	 * @return Whether or not the cell is occupied.
+	 */
+	template <typename E>
+	constexpr bool isOccupiedCell(const E& cell) {
+		if constexpr (std::ranges::range<const E>)
+			return std::ranges::begin(cell) != std::ranges::end(cell);
+		else
+			return static_cast<bool>(cell);
+	}
+
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Records which cells of a 2D table (represented by vectors) are occupied, as one bitmap per row, and which columns are occupied in any row, as the union of the bitmaps.
+	 * @details Building the index visits every cell once; the union is then computed a few words (SIMD registers, where available) per row. Tables of at least `MIN_ROWS_PER_THREAD` rows per thread are indexed on several threads. Afterwards, occupied cells and columns can be iterated without probing the table.
+	 */
+	class ColumnOccupancyIndex {
+		size_t m_RowCount = 0;
+		size_t m_ColumnCount = 0;
+		size_t m_WordCount = 0;
+		std::vector<uint64_t> m_Rows;
+		std::vector<uint64_t> m_Columns;
+
+		void forEachChunk(size_t, const std::function<void(size_t, size_t)>&) const;
+		void combineRows(size_t);
+
+		/**
+		 * @brief Calls `f` with the index of every set bit of `bits`, in ascending order.
+		 */
+		template <typename F>
+		static void forEachSetBit(std::span<const uint64_t> bits, F&& f) {
+			for (size_t word = 0; word < bits.size(); word++)
+				for (uint64_t rest = bits[word]; rest; rest &= rest - 1)
+					f(word * BITS_PER_WORD + (size_t)std::countr_zero(rest));
+		}
+
+	public:
+
+		static constexpr size_t BITS_PER_WORD = 64;
+		static constexpr size_t MIN_ROWS_PER_THREAD = 1 << 12;
+
+		ColumnOccupancyIndex() = default;
+
+		/**
+		 * @brief Indexes the occupied cells of a table (see `isOccupiedCell`).
+		 * @tparam E The type of the cells.
+		 * @param[in] table The table. Rows may have different sizes.
+		 * @param[in] threadCount The maximum number of threads, including the calling one (0 uses `std::thread::hardware_concurrency`).
+		 */
+		template <typename E>
+		explicit ColumnOccupancyIndex(const std::vector<std::vector<E>>& table, size_t threadCount = 0)
+			: m_RowCount(table.size())
+		{
+			for (const auto& row : table)
+				m_ColumnCount = std::max(m_ColumnCount, row.size());
+
+			m_WordCount = (m_ColumnCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+			m_Rows.assign(m_RowCount * m_WordCount, 0);
+
+			forEachChunk(threadCount, [this, &table](size_t first, size_t last) {
+				for (size_t row = first; row < last; row++) {
+					uint64_t* const bits = m_Rows.data() + row * m_WordCount;
+					const auto& cells = table[row];
+
+					for (size_t column = 0; column < cells.size(); column++)
+						bits[column / BITS_PER_WORD] |= uint64_t(isOccupiedCell(cells[column])) << (column % BITS_PER_WORD);
+				}
+				});
+
+			combineRows(threadCount);
+		}
+
+		size_t getRowCount() const {
+			return m_RowCount;
+		}
+
+		/**
+		 * @return The size of the largest row.
+		 */
+		size_t getColumnCount() const {
+			return m_ColumnCount;
+		}
+
+		/**
+		 * @return The number of 64-bit words of each bitmap.
+		 */
+		size_t getWordCount() const {
+			return m_WordCount;
+		}
+
+		bool isOccupied(size_t row, size_t column) const {
+			return column < m_ColumnCount && (m_Rows[row * m_WordCount + column / BITS_PER_WORD] >> (column % BITS_PER_WORD) & 1);
+		}
+
+		/**
+		 * @return The bitmap of the occupied cells of a row: bit `c % 64` of word `c / 64` is set if column `c` is occupied.
+		 */
+		std::span<const uint64_t> getRow(size_t row) const {
+			return { m_Rows.data() + row * m_WordCount, m_WordCount };
+		}
+
+		/**
+		 * @return The bitmap of the columns occupied in any row (laid out as in `getRow`).
+		 */
+		std::span<const uint64_t> getColumns() const {
+			return m_Columns;
+		}
+
+		size_t countOccupiedColumns() const;
+		std::vector<size_t> getOccupiedColumns() const;
+
+		/**
+		 * @brief Calls `f` with the index of every occupied cell of a row, in ascending order.
+		 */
+		template <typename F>
+		void forEachOccupied(size_t row, F&& f) const {
+			forEachSetBit(getRow(row), std::forward<F>(f));
+		}
+
+		/**
+		 * @brief Calls `f` with the index of every column occupied in any row, in ascending order.
+		 */
+		template <typename F>
+		void forEachOccupiedColumn(F&& f) const {
+			forEachSetBit(m_Columns, std::forward<F>(f));
+		}
+
+	};
+
+	/**
+	 * @brief Finds the columns of a table that are occupied in at least one row, using a `ColumnOccupancyIndex`. This is the library's own `getNonEmptyColumns` callback of the 2D-table `toString`.
+	 * @tparam E The type of the cells (see `isOccupiedCell`).
+	 * @param[in] table The table.
+	 * @return The indices of the occupied columns.
+	 */
+	template <typename E>
+	std::set<size_t> findNonEmptyColumns(const std::vector<std::vector<E>>& table) {
+		const std::vector<size_t> columns = ColumnOccupancyIndex{ table }.getOccupiedColumns();
+
+		return { columns.begin(), columns.end() };
+	}
+
+}
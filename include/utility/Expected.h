@@ -0,0 +1,180 @@
+#pragma once
+
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <version>
+
+#ifdef __cpp_lib_expected
+#include <expected>
+#endif
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// EXCEPTIONS
+namespace m0st4fa::utility {
+
+#ifdef __cpp_lib_expected
+
+	template <typename E>
+	using BadExpectedAccess = std::bad_expected_access<E>;
+
+#else
+
+	/**
+	 * @brief An exception thrown by `Expected::value` when the `Expected` holds an error (`std::bad_expected_access`, where the standard library lacks it).
+	 * @tparam E The type of the error.
+	 */
+	template <typename E>
+	class BadExpectedAccess : public std::exception {
+		E m_Error;
+
+	public:
+
+		explicit BadExpectedAccess(E error)
+			: m_Error(std::move(error))
+		{
+		}
+
+		const char* what() const noexcept(true) override {
+			return "Bad expected access: the Expected holds an error.";
+		}
+
+		const E& error() const& {
+			return m_Error;
+		}
+
+	};
+
+#endif
+
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+#ifdef __cpp_lib_expected
+
+	template <typename T, typename E>
+	using Expected = std::expected<T, E>;
+
+	template <typename E>
+	using Unexpected = std::unexpected<E>;
+
+#else
+
+	/**
+	 * @brief Wraps an error to construct an `Expected` holding it (`std::unexpected`, where the standard library lacks it).
+	 * @tparam E The type of the error.
+	 */
+	template <typename E>
+	class Unexpected {
+		E m_Error;
+
+	public:
+
+		constexpr explicit Unexpected(E error)
+			: m_Error(std::move(error))
+		{
+		}
+
+		constexpr const E& error() const& {
+			return m_Error;
+		}
+
+		constexpr E&& error() && {
+			return std::move(m_Error);
+		}
+
+	};
+
+	/**
+	 * @brief Either a value or an error: the subset of `std::expected` the library uses, for standard libraries without it.
+	 * @details Nothing is allocated: the value or the error is stored in place.
+	 * @tparam T The type of the value.
+	 * @tparam E The type of the error.
+	 */
+	template <typename T, typename E>
+	class Expected {
+		std::variant<T, E> m_Storage;
+
+	public:
+
+		using value_type = T;
+		using error_type = E;
+
+		template <typename U = T>
+			requires std::is_constructible_v<T, U&&>
+		constexpr Expected(U&& value)
+			: m_Storage(std::in_place_index<0>, std::forward<U>(value))
+		{
+		}
+
+		template <typename G>
+		constexpr Expected(Unexpected<G> error)
+			: m_Storage(std::in_place_index<1>, std::move(error).error())
+		{
+		}
+
+		constexpr bool has_value() const {
+			return m_Storage.index() == 0;
+		}
+
+		constexpr explicit operator bool() const {
+			return has_value();
+		}
+
+		/**
+		 * @throws BadExpectedAccess<E> If the `Expected` holds an error.
+		 */
+		constexpr const T& value() const& {
+			if (!has_value())
+				throw BadExpectedAccess<E>{ error() };
+
+			return **this;
+		}
+
+		constexpr T& value()& {
+			if (!has_value())
+				throw BadExpectedAccess<E>{ error() };
+
+			return **this;
+		}
+
+		/**
+		 * @brief Accesses the value without checking that there is one.
+		 * @attention The `Expected` must hold a value.
+		 */
+		constexpr const T& operator*() const& {
+			return *std::get_if<0>(&m_Storage);
+		}
+
+		constexpr T& operator*()& {
+			return *std::get_if<0>(&m_Storage);
+		}
+
+		constexpr const T* operator->() const {
+			return std::get_if<0>(&m_Storage);
+		}
+
+		/**
+		 * @throws std::bad_variant_access If the `Expected` holds a value.
+		 */
+		constexpr const E& error() const& {
+			return std::get<1>(m_Storage);
+		}
+
+		template <typename U>
+		constexpr T value_or(U&& fallback) const& {
+			return has_value() ? **this : static_cast<T>(std::forward<U>(fallback));
+		}
+
+	};
+
+#endif
+
+}
@@ -0,0 +1,459 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Membership.h"
+#include "SetUnion.h"
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief A set stored as a sorted array: in place for up to `N` elements, so that small sets allocate nothing, and in a single heap buffer beyond that.
+	 * @details Its interface is the subset of `std::set`'s the library uses (`insert`, `contains`, `find`, `erase`, ...), plus `at`, so that it is an iterable for `toString`, `isIn`, `insertAndAssert` and the iterable `operator==`.
+	 * Elements are found with a linear search a vector register at a time (see `findValue`) in small sets of numbers, and with a binary search otherwise. An insertion or an erasure moves the elements after it, in O(n), which for small sets is faster than the allocation of a node of `std::set`.
+	 * A set that has outgrown its inline storage keeps its heap buffer, even if it shrinks back.
+	 * @tparam T The type of the elements, ordered by `<`.
+	 * @tparam N The number of elements stored in place.
+	 */
+	template <typename T, size_t N = 8>
+		requires (N > 0)
+	class FlatSet {
+		T* m_Data;
+		size_t m_Size = 0;
+		size_t m_Capacity = N;
+		alignas(T) std::byte m_Inline[N * sizeof(T)];
+
+		T* getInlineData() {
+			return std::launder(reinterpret_cast<T*>(m_Inline));
+		}
+
+		const T* getInlineData() const {
+			return std::launder(reinterpret_cast<const T*>(m_Inline));
+		}
+
+		/**
+		 * @brief Moves the elements to a heap buffer of `capacity` elements.
+		 */
+		void reallocate(size_t capacity) {
+			T* const data = std::allocator<T>{}.allocate(capacity);
+
+			std::uninitialized_move(m_Data, m_Data + m_Size, data);
+			std::destroy(m_Data, m_Data + m_Size);
+
+			if (!isInline())
+				std::allocator<T>{}.deallocate(m_Data, m_Capacity);
+
+			m_Data = data;
+			m_Capacity = capacity;
+		}
+
+		/**
+		 * @brief Destroys the elements and frees the heap buffer, if any, leaving the set empty and inline.
+		 */
+		void release() {
+			std::destroy(m_Data, m_Data + m_Size);
+
+			if (!isInline())
+				std::allocator<T>{}.deallocate(m_Data, m_Capacity);
+
+			m_Data = getInlineData();
+			m_Size = 0;
+			m_Capacity = N;
+		}
+
+		/**
+		 * @brief Takes the elements of `other` over, leaving it empty: its heap buffer, if it has one, and its inline elements (moved) otherwise.
+		 * @attention The set must be empty and inline.
+		 */
+		void adopt(FlatSet&& other) {
+			if (other.isInline()) {
+				std::uninitialized_move(other.m_Data, other.m_Data + other.m_Size, m_Data);
+				m_Size = other.m_Size;
+				other.clear();
+				return;
+			}
+
+			m_Data = other.m_Data;
+			m_Size = other.m_Size;
+			m_Capacity = other.m_Capacity;
+
+			other.m_Data = other.getInlineData();
+			other.m_Size = 0;
+			other.m_Capacity = N;
+		}
+
+		/**
+		 * @brief Inserts `value` at `index`, moving the elements after it one place further.
+		 * @attention The value must belong at `index` and must not be an element of the set.
+		 */
+		template <typename U>
+		T* insertAt(size_t index, U&& value) {
+			if (m_Size == m_Capacity)
+				reallocate(m_Capacity * 2);
+
+			if (index == m_Size)
+				std::construct_at(m_Data + m_Size, std::forward<U>(value));
+			else {
+				std::construct_at(m_Data + m_Size, std::move(m_Data[m_Size - 1]));
+				std::move_backward(m_Data + index, m_Data + m_Size - 1, m_Data + m_Size);
+				m_Data[index] = T(std::forward<U>(value));
+			}
+
+			m_Size++;
+			return m_Data + index;
+		}
+
+		/**
+		 * @brief Constructs an element after the last one, without checking the order or the capacity.
+		 */
+		template <typename U>
+		void append(U&& value) {
+			std::construct_at(m_Data + m_Size, std::forward<U>(value));
+			m_Size++;
+		}
+
+		/**
+		 * @brief Merges sorted elements into the set, in a single pass into a new buffer.
+		 * @return The number of elements inserted.
+		 */
+		template <std::forward_iterator It, std::sentinel_for<It> S>
+		size_t mergeSorted(It first, S last) {
+			FlatSet merged;
+			merged.reserve(m_Size + (size_t)std::ranges::distance(first, last));
+
+			size_t index = 0;
+
+			for (; first != last; ++first) {
+				auto&& value = *first;
+
+				while (index < m_Size && m_Data[index] < value)
+					merged.append(std::move(m_Data[index++]));
+
+				// already in the set, or a duplicate of the element merged last
+				if ((index < m_Size && !(value < m_Data[index])) || (merged.m_Size && !(merged.m_Data[merged.m_Size - 1] < value)))
+					continue;
+
+				merged.append(std::forward<decltype(value)>(value));
+			}
+
+			while (index < m_Size)
+				merged.append(std::move(m_Data[index++]));
+
+			const size_t added = merged.m_Size - m_Size;
+			*this = std::move(merged);
+
+			return added;
+		}
+
+	public:
+
+		using key_type = T;
+		using value_type = T;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using key_compare = std::less<T>;
+		using value_compare = std::less<T>;
+		using reference = const T&;
+		using const_reference = const T&;
+		using pointer = const T*;
+		using const_pointer = const T*;
+		using iterator = const T*;
+		using const_iterator = const T*;
+
+		/**
+		 * @brief The number of elements the set stores in place.
+		 */
+		static constexpr size_t INLINE_CAPACITY = N;
+
+		/**
+		 * @brief The size up to which the sets of numbers are searched linearly (with `findValue`) rather than by a binary search.
+		 */
+		static constexpr size_t MAX_LINEAR_SEARCH_SIZE = 64;
+
+		FlatSet()
+			: m_Data(getInlineData())
+		{
+		}
+
+		FlatSet(std::initializer_list<T> values)
+			: FlatSet()
+		{
+			insert(values.begin(), values.end());
+		}
+
+		template <std::input_iterator It, std::sentinel_for<It> S>
+		FlatSet(It first, S last)
+			: FlatSet()
+		{
+			insert(first, last);
+		}
+
+		FlatSet(const FlatSet& other)
+			: FlatSet()
+		{
+			reserve(other.m_Size);
+			std::uninitialized_copy(other.m_Data, other.m_Data + other.m_Size, m_Data);
+			m_Size = other.m_Size;
+		}
+
+		FlatSet(FlatSet&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: FlatSet()
+		{
+			adopt(std::move(other));
+		}
+
+		FlatSet& operator=(const FlatSet& other) {
+			if (this == &other)
+				return *this;
+
+			clear();
+			reserve(other.m_Size);
+			std::uninitialized_copy(other.m_Data, other.m_Data + other.m_Size, m_Data);
+			m_Size = other.m_Size;
+
+			return *this;
+		}
+
+		FlatSet& operator=(FlatSet&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+			if (this == &other)
+				return *this;
+
+			release();
+			adopt(std::move(other));
+
+			return *this;
+		}
+
+		~FlatSet() {
+			release();
+		}
+
+		const T* begin() const {
+			return m_Data;
+		}
+
+		const T* end() const {
+			return m_Data + m_Size;
+		}
+
+		const T* cbegin() const {
+			return begin();
+		}
+
+		const T* cend() const {
+			return end();
+		}
+
+		const T* data() const {
+			return m_Data;
+		}
+
+		size_t size() const {
+			return m_Size;
+		}
+
+		bool empty() const {
+			return m_Size == 0;
+		}
+
+		size_t capacity() const {
+			return m_Capacity;
+		}
+
+		/**
+		 * @return Whether the elements are stored in place (rather than on the heap).
+		 */
+		bool isInline() const {
+			return m_Data == getInlineData();
+		}
+
+		/**
+		 * @return The `index`th smallest element.
+		 * @throws std::out_of_range if `index` is not less than the size of the set.
+		 */
+		const T& at(size_t index) const {
+			if (index >= m_Size)
+				throw std::out_of_range("FlatSet::at: index out of range");
+
+			return m_Data[index];
+		}
+
+		const T* lower_bound(const T& value) const {
+			return std::lower_bound(begin(), end(), value);
+		}
+
+		const T* upper_bound(const T& value) const {
+			return std::upper_bound(begin(), end(), value);
+		}
+
+		/**
+		 * @return The element equal to `value`, or `end()` if there is none.
+		 */
+		const T* find(const T& value) const {
+			if constexpr (IS_SEARCHABLE_VALUE<T>)
+				if (m_Size <= MAX_LINEAR_SEARCH_SIZE)
+					return m_Data + findValue(std::span<const T>{ m_Data, m_Size }, value);
+
+			const T* const it = lower_bound(value);
+
+			return it != end() && !(value < *it) ? it : end();
+		}
+
+		bool contains(const T& value) const {
+			return find(value) != end();
+		}
+
+		size_t count(const T& value) const {
+			return contains(value);
+		}
+
+		/**
+		 * @return The element equal to `value` and whether it has been inserted (`false` if it was already in the set).
+		 */
+		std::pair<const T*, bool> insert(const T& value) {
+			const T* const it = lower_bound(value);
+
+			if (it != end() && !(value < *it))
+				return { it, false };
+
+			return { insertAt(size_t(it - m_Data), value), true };
+		}
+
+		std::pair<const T*, bool> insert(T&& value) {
+			const T* const it = lower_bound(value);
+
+			if (it != end() && !(value < *it))
+				return { it, false };
+
+			return { insertAt(size_t(it - m_Data), std::move(value)), true };
+		}
+
+		/**
+		 * @brief Inserts `value` right before `hint` if it belongs there (as with `std::inserter`), and searches for its place otherwise.
+		 * @return The element equal to `value`.
+		 */
+		const T* insert(const T* hint, const T& value) {
+			if ((hint == begin() || *(hint - 1) < value) && (hint == end() || value < *hint))
+				return insertAt(size_t(hint - m_Data), value);
+
+			return insert(value).first;
+		}
+
+		/**
+		 * @brief Inserts a range of elements: sorted ones (as those of another set) are merged in O(n + m), and others are inserted one by one.
+		 * @return The number of elements inserted.
+		 */
+		template <std::input_iterator It, std::sentinel_for<It> S>
+		size_t insert(It first, S last) {
+			if constexpr (std::forward_iterator<It>)
+				if (first != last && std::ranges::is_sorted(first, last))
+					return mergeSorted(first, last);
+
+			size_t added = 0;
+
+			for (; first != last; ++first)
+				added += insert(*first).second;
+
+			return added;
+		}
+
+		size_t insert(std::initializer_list<T> values) {
+			return insert(values.begin(), values.end());
+		}
+
+		/**
+		 * @return The number of elements erased (0 or 1).
+		 */
+		size_t erase(const T& value) {
+			const T* const it = find(value);
+
+			if (it == end())
+				return 0;
+
+			erase(it);
+			return 1;
+		}
+
+		/**
+		 * @return The element after the erased one.
+		 */
+		const T* erase(const T* position) {
+			T* const it = m_Data + (position - m_Data);
+
+			std::move(it + 1, m_Data + m_Size, it);
+			std::destroy_at(m_Data + m_Size - 1);
+			m_Size--;
+
+			return it;
+		}
+
+		void clear() {
+			std::destroy(m_Data, m_Data + m_Size);
+			m_Size = 0;
+		}
+
+		void reserve(size_t capacity) {
+			if (capacity > m_Capacity)
+				reallocate(capacity);
+		}
+
+		friend bool operator==(const FlatSet& lhs, const FlatSet& rhs) {
+			return std::ranges::equal(lhs, rhs);
+		}
+
+		friend auto operator<=>(const FlatSet& lhs, const FlatSet& rhs) requires std::three_way_comparable<T> {
+			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+	};
+
+	template <typename T, size_t N, typename Compare>
+	inline constexpr bool IS_SORTED_BY<FlatSet<T, N>, Compare> = IS_LESS<Compare>;
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Inserts the elements of an iterable into a `FlatSet`: merged in O(n + m) if they are sorted (see `FlatSet::insert`); moved if `from` is an rvalue.
+	 * @details An rvalue `FlatSet` of the same type is moved as a whole into an empty one.
+	 * @return The number of elements inserted.
+	 */
+	template <typename FromT, typename T, size_t N>
+	InsertResult insertAll(FromT&& from, FlatSet<T, N>& to) {
+		if (static_cast<const void*>(&from) == static_cast<const void*>(&to))
+			return {};
+
+		constexpr bool movable = !std::is_lvalue_reference_v<FromT> && !std::is_const_v<std::remove_reference_t<FromT>>;
+
+		if constexpr (std::same_as<std::remove_cvref_t<FromT>, FlatSet<T, N>> && movable)
+			if (to.empty()) {
+				to = std::move(from);
+				return { to.size() };
+			}
+
+		if constexpr (movable && std::ranges::common_range<FromT>)
+			return { to.insert(std::make_move_iterator(std::ranges::begin(from)), std::make_move_iterator(std::ranges::end(from))) };
+		else
+			return { to.insert(std::ranges::begin(from), std::ranges::end(from)) };
+	}
+
+}
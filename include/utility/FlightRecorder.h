@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+#include "fmt/format.h"
+#include "LockFreeQueue.h"
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	enum class LOG_LEVEL;
+
+	/**
+	 * @brief An always-on, in-memory record of the latest messages of every thread, dumped when something goes wrong.
+	 * @details Every thread owns a fixed-size ring of fixed-size slots, allocated once, so recording a message never allocates: it is a clock read plus a copy (or a `format_to_n`) into the next slot, overwriting the oldest one. Messages longer than a slot are truncated. Slots are guarded by sequence numbers, so that dumping from another thread never reads a half-written message. `Logger` records every message it writes (and, while the recorder is enabled, the ones it discards at runtime: for their level, a switched-off callsite or a rate limit; messages below `UTILITY_LOG_MIN_LEVEL` are compiled out and never recorded) and dumps the recorder to `std::cerr` when a fatal error is logged.
+	 */
+	class FlightRecorder {
+	public:
+
+		static constexpr size_t SLOT_SIZE = 256;
+		static constexpr size_t SLOT_COUNT = 1024;
+
+		/**
+		 * @brief A recorded message.
+		 */
+		struct alignas(utility::CACHE_LINE_SIZE) Slot {
+			std::atomic<uint64_t> sequence{ 0 };	///< Odd while the slot is being written.
+			int64_t timestamp = 0;
+			uint8_t level = 0;
+			uint16_t size = 0;
+			char text[SLOT_SIZE - sizeof(std::atomic<uint64_t>) - sizeof(int64_t) - sizeof(uint8_t) - sizeof(uint16_t) - 4]{};
+		};
+
+		static constexpr size_t TEXT_SIZE = sizeof(Slot::text);
+
+	private:
+
+		static inline std::atomic<bool> s_Enabled{ false };
+
+		static Slot& beginSlot(LOG_LEVEL);
+		static void endSlot(Slot&, size_t);
+
+	public:
+
+		/**
+		 * @brief Enables or disables recording.
+		 */
+		static void setEnabled(bool enabled) {
+			s_Enabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return `true` if messages are being recorded; `false` otherwise.
+		 */
+		static bool isEnabled() {
+			return s_Enabled.load(std::memory_order_relaxed);
+		}
+
+		static void record(LOG_LEVEL, std::string_view);
+
+		/**
+		 * @brief Formats a message straight into the next slot of the current thread.
+		 * @param[in] level The level of the message.
+		 * @param[in] formatStr The format string of the message.
+		 * @param[in] args The arguments to be formatted.
+		 */
+		template <typename... Args>
+		static void record(LOG_LEVEL level, fmt::format_string<Args...> formatStr, Args&&... args) {
+			Slot& slot = beginSlot(level);
+			const auto result = fmt::format_to_n(slot.text, TEXT_SIZE, formatStr, std::forward<Args>(args)...);
+
+			endSlot(slot, result.size);
+		}
+
+		static size_t dump(std::ostream& = std::cerr);
+		static void clear();
+
+	};
+
+}
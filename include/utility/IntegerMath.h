@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "NumberFormat.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Multiplies two 64-bit integers, detecting overflow (with the compiler's builtin, where there is one).
+	 * @param[in] a The first factor.
+	 * @param[in] b The second factor.
+	 * @param[out] product The product, modulo 2^64.
+	 * @return `false` if the product does not fit into 64 bits.
+	 */
+	constexpr bool multiplyChecked(uint64_t a, uint64_t b, uint64_t& product) {
+#if defined(__GNUC__) || defined(__clang__)
+		return !__builtin_mul_overflow(a, b, &product);
+#else
+		product = a * b;
+		return a == 0 || b <= std::numeric_limits<uint64_t>::max() / a;
+#endif
+	}
+
+	/**
+	 * @brief Raises `base` to the power of `exponent` by squaring, in O(log(exponent)) multiplications.
+	 * @details The result wraps around on overflow, as the multiplications of unsigned integers do (for signed integers, the result is that of the unsigned multiplications, converted back).
+	 * @tparam T The type of the base and of the result.
+	 * @param[in] base The base of the exponentiation.
+	 * @param[in] exponent The power of the exponentiation.
+	 * @return `base` raised to the power of `exponent`.
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool>)
+	constexpr T pow(T base, uint64_t exponent) {
+		// small types are multiplied as `unsigned`, which, unlike `int`, wraps around
+		using UnsignedT = std::conditional_t<(sizeof(T) < sizeof(unsigned)), unsigned, std::make_unsigned_t<T>>;
+
+		UnsignedT factor = (UnsignedT)base;
+		UnsignedT result = 1;
+
+		while (exponent) {
+			if (exponent & 1)
+				result *= factor;
+
+			exponent >>= 1;
+
+			if (exponent)
+				factor *= factor;
+		}
+
+		return (T)result;
+	}
+
+	/**
+	 * @brief Raises `base` to the power of `exponent` (see `pow`), detecting overflow.
+	 * @return `base` raised to the power of `exponent`, or nothing if it does not fit into a `T`.
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool>)
+	constexpr std::optional<T> checkedPow(T base, uint64_t exponent) {
+		const bool negative = base < 0 && (exponent & 1);
+
+		// the magnitude of the most negative value is one more than that of the maximum
+		const uint64_t limit = (uint64_t)std::numeric_limits<T>::max() + negative;
+		uint64_t factor = base < 0 ? uint64_t(0) - (uint64_t)base : (uint64_t)base;
+		uint64_t magnitude = 1;
+
+		while (exponent) {
+			if ((exponent & 1) && (!multiplyChecked(magnitude, factor, magnitude) || magnitude > limit))
+				return std::nullopt;
+
+			exponent >>= 1;
+
+			// the squared factor is multiplied into the result later, so it must fit as well
+			if (exponent && (!multiplyChecked(factor, factor, factor) || factor > limit))
+				return std::nullopt;
+		}
+
+		return negative ? (T)(uint64_t(0) - magnitude) : (T)magnitude;
+	}
+
+	/**
+	 * @brief Raises `base` to the power of `exponent` (see `pow`), saturating on overflow.
+	 * @return `base` raised to the power of `exponent`, or the maximum (or, for a negative result, the minimum) of `T` if it does not fit.
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool>)
+	constexpr T saturatingPow(T base, uint64_t exponent) {
+		if (const std::optional<T> result = checkedPow(base, exponent))
+			return *result;
+
+		return base < 0 && (exponent & 1) ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+	}
+
+	/**
+	 * @brief Computes `(a * b) % modulus` without overflow: with a 128-bit product where the compiler has 128-bit integers, directly for moduli below 2^32, and by doubling otherwise.
+	 */
+	constexpr uint64_t mulMod(uint64_t a, uint64_t b, uint64_t modulus) {
+#ifdef __SIZEOF_INT128__
+		return (uint64_t)((unsigned __int128)a * b % modulus);
+#else
+		a %= modulus;
+		b %= modulus;
+
+		if (modulus <= std::numeric_limits<uint32_t>::max())
+			return a * b % modulus;
+
+		uint64_t result = 0;
+
+		for (; b; b >>= 1) {
+			if (b & 1)
+				result = result >= modulus - a ? result - (modulus - a) : result + a;
+
+			a = a >= modulus - a ? a - (modulus - a) : a + a;
+		}
+
+		return result;
+#endif
+	}
+
+	/**
+	 * @brief Raises `base` to the power of `exponent` modulo `modulus`, by squaring (see `mulMod`).
+	 * @param[in] base The base of the exponentiation.
+	 * @param[in] exponent The power of the exponentiation.
+	 * @param[in] modulus The modulus; it must not be 0.
+	 * @return `base` raised to the power of `exponent`, modulo `modulus`.
+	 */
+	constexpr uint64_t powMod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+		uint64_t result = 1 % modulus;
+		base %= modulus;
+
+		while (exponent) {
+			if (exponent & 1)
+				result = mulMod(result, base, modulus);
+
+			exponent >>= 1;
+
+			if (exponent)
+				base = mulMod(base, base, modulus);
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Computes the integer (floor) binary logarithm of a positive integer.
+	 * @return The index of the highest set bit of `value`; 0 for 0.
+	 */
+	template <std::unsigned_integral T>
+	constexpr int ilog2(T value) {
+		return std::bit_width(T(value | 1)) - 1;
+	}
+
+	/**
+	 * @brief Computes the integer (floor) decimal logarithm of a positive integer (see `countDigits`).
+	 * @return The number of decimal digits of `value`, minus one; 0 for 0.
+	 */
+	template <std::unsigned_integral T>
+	constexpr int ilog10(T value) {
+		return (int)countDigits(value) - 1;
+	}
+
+	/**
+	 * @brief Computes the integer (floor) square root of an integer.
+	 * @details At runtime, the square root of the nearest `double` is corrected by at most a step or two; in constant expressions, Newton's method is used.
+	 * @return The largest integer whose square is not greater than `value`.
+	 */
+	template <std::unsigned_integral T>
+	constexpr T isqrt(T value) {
+		const uint64_t n = value;
+
+		if (n < 2)
+			return value;
+
+		uint64_t root = 0;
+
+		if (std::is_constant_evaluated()) {
+			// Newton's method from above: from a power of two not smaller than the root, the estimates decrease down to it
+			root = uint64_t(1) << ((std::bit_width(n) + 1) / 2);
+
+			for (uint64_t next = (root + n / root) / 2; next < root; next = (root + n / root) / 2)
+				root = next;
+
+			return (T)root;
+		}
+
+		root = std::min<uint64_t>((uint64_t)std::sqrt((double)n), std::numeric_limits<uint32_t>::max());
+
+		while (root * root > n)
+			root--;
+
+		while (root < std::numeric_limits<uint32_t>::max() && (root + 1) * (root + 1) <= n)
+			root++;
+
+		return (T)root;
+	}
+
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief How `areEqualAsMultisets` compares two iterables, as chosen from the traits of their elements by `getEqualityStrategy`.
+	 */
+	enum class EQUALITY_STRATEGY {
+		ES_SORTED_VALUES,		///< Arithmetic elements: both iterables are copied, sorted and compared as blocks of memory (or, for floating-point numbers, element by element).
+		ES_HASHED_COUNTS,		///< Hashable elements: the occurrences of each element are counted up in one iterable and down in the other.
+		ES_SORTED_REFERENCES,	///< Totally ordered elements: references to the elements of both iterables are sorted and merged, so that no element is copied.
+		ES_PAIRWISE,			///< Elements only comparable with "==": each element of one iterable is matched to an unmatched equal element of the other, in O(n²).
+		ES_COUNT
+	};
+
+	/**
+	 * @brief The number of elements below which the sorting strategies of `areEqualAsMultisets` run on the calling thread only.
+	 */
+	inline constexpr size_t MIN_ELEMENTS_PER_SORT_THREAD = 1 << 15;
+
+}
+
+// CONCEPTS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Checks whether `T` has an enabled `std::hash` specialization.
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept Hashable = requires (const T & a) {
+		{ std::hash<T>{}(a) } -> std::convertible_to<size_t>;
+	};
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Chooses how iterables of elements of type `T` are compared by `areEqualAsMultisets`.
+	 * @tparam T The type of the elements.
+	 */
+	template <typename T>
+	consteval EQUALITY_STRATEGY getEqualityStrategy() {
+		if constexpr (std::is_arithmetic_v<T>)
+			return EQUALITY_STRATEGY::ES_SORTED_VALUES;
+		else if constexpr (Hashable<T> && std::equality_comparable<T>)
+			return EQUALITY_STRATEGY::ES_HASHED_COUNTS;
+		else if constexpr (std::totally_ordered<T>)
+			return EQUALITY_STRATEGY::ES_SORTED_REFERENCES;
+		else
+			return EQUALITY_STRATEGY::ES_PAIRWISE;
+	}
+
+	/**
+	 * @brief Sorts `values`: contiguous chunks of at least `MIN_ELEMENTS_PER_SORT_THREAD` elements are sorted on separate threads and then merged. The first chunk is sorted on the calling thread.
+	 * @param[in,out] values The values to be sorted.
+	 * @param[in] compare The strict weak ordering of the values.
+	 * @param[in] threadCount The maximum number of threads, including the calling one (0 uses `std::thread::hardware_concurrency`).
+	 */
+	template <typename T, typename Compare = std::less<>>
+	void parallelSort(std::span<T> values, Compare compare = {}, size_t threadCount = 0) {
+		if (!threadCount)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		const size_t chunkCount = std::clamp<size_t>(values.size() / MIN_ELEMENTS_PER_SORT_THREAD, 1, threadCount);
+
+		if (chunkCount == 1) {
+			std::sort(values.begin(), values.end(), compare);
+			return;
+		}
+
+		std::vector<size_t> bounds(chunkCount + 1);
+
+		for (size_t chunk = 0; chunk <= chunkCount; chunk++)
+			bounds[chunk] = values.size() * chunk / chunkCount;
+
+		auto sort = [&values, &bounds, &compare](size_t chunk) {
+			std::sort(values.begin() + bounds[chunk], values.begin() + bounds[chunk + 1], compare);
+			};
+
+		std::vector<std::thread> threads;
+		threads.reserve(chunkCount - 1);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++)
+			threads.emplace_back(sort, chunk);
+
+		sort(0);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		// merge runs of `width` chunks pairwise, doubling the width until a single run is left
+		for (size_t width = 1; width < chunkCount; width *= 2)
+			for (size_t chunk = 0; chunk + width < chunkCount; chunk += 2 * width)
+				std::inplace_merge(values.begin() + bounds[chunk], values.begin() + bounds[chunk + width], values.begin() + bounds[std::min(chunk + 2 * width, chunkCount)], compare);
+	}
+
+	/**
+	 * @brief Sorts the two spans, each with half of the threads (see `parallelSort`); `lhs` on a separate thread if either is large enough to be split.
+	 */
+	template <typename T, typename Compare>
+	void parallelSortBoth(std::span<T> lhs, std::span<T> rhs, Compare compare, size_t threadCount) {
+		if (!threadCount)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		if (threadCount == 1 || lhs.size() < MIN_ELEMENTS_PER_SORT_THREAD) {
+			parallelSort(lhs, compare, threadCount);
+			parallelSort(rhs, compare, threadCount);
+			return;
+		}
+
+		std::thread thread{ [&] { parallelSort(lhs, compare, threadCount / 2); } };
+		parallelSort(rhs, compare, threadCount - threadCount / 2);
+		thread.join();
+	}
+
+	/**
+	 * @brief Checks whether two iterables hold the same elements, the same number of times each, in any order (i.e., whether they are equal as multisets).
+	 * @details The strategy is chosen at compile time from the traits of the elements (see `getEqualityStrategy`): O(n log(n)) for arithmetic and ordered elements, sorted on several threads if there are many (see `parallelSort`); O(n) (on average) for hashable ones; and O(n²) for elements only comparable with "==".
+	 * @note Floating-point NaNs are not equal to anything, so iterables holding any are never equal.
+	 * @tparam IterableT The type of the iterables.
+	 * @param[in] lhs The left-hand-side of the equality.
+	 * @param[in] rhs The right-hand-side of the equality.
+	 * @param[in] threadCount The maximum number of threads used to sort (0 uses `std::thread::hardware_concurrency`).
+	 * @return `true` if both iterables are equal as multisets; `false` otherwise.
+	 */
+	template <std::ranges::sized_range IterableT>
+	bool areEqualAsMultisets(const IterableT& lhs, const IterableT& rhs, size_t threadCount = 0) {
+		using ElementT = std::ranges::range_value_t<IterableT>;
+
+		// the elements of iterables of proxies (such as `std::vector<bool>`) have no addresses to be referenced by
+		constexpr EQUALITY_STRATEGY preferred = getEqualityStrategy<ElementT>();
+		constexpr EQUALITY_STRATEGY strategy = preferred == EQUALITY_STRATEGY::ES_SORTED_VALUES || std::is_lvalue_reference_v<std::ranges::range_reference_t<const IterableT>> ? preferred : EQUALITY_STRATEGY::ES_PAIRWISE;
+
+		const size_t size = (size_t)std::ranges::size(lhs);
+
+		if (size != (size_t)std::ranges::size(rhs))
+			return false;
+
+		if constexpr (strategy == EQUALITY_STRATEGY::ES_SORTED_VALUES) {
+			// `bool`s are sorted as bytes, since `std::vector<bool>` does not store them in an array
+			using ValueT = std::conditional_t<std::same_as<ElementT, bool>, unsigned char, ElementT>;
+
+			std::vector<ValueT> lhsValues(std::ranges::begin(lhs), std::ranges::end(lhs));
+			std::vector<ValueT> rhsValues(std::ranges::begin(rhs), std::ranges::end(rhs));
+
+			if constexpr (std::is_floating_point_v<ValueT>) {
+				auto isNaN = [](ValueT value) { return std::isnan(value); };
+
+				// NaNs would break the ordering the sort relies upon
+				if (std::ranges::any_of(lhsValues, isNaN) || std::ranges::any_of(rhsValues, isNaN))
+					return false;
+			}
+
+			parallelSortBoth(std::span{ lhsValues }, std::span{ rhsValues }, std::less<>{}, threadCount);
+
+			// equal integers are equal bit for bit, unlike floating-point zeros of different signs
+			if constexpr (std::is_integral_v<ValueT>)
+				return size == 0 || std::memcmp(lhsValues.data(), rhsValues.data(), size * sizeof(ValueT)) == 0;
+			else
+				return std::ranges::equal(lhsValues, rhsValues);
+		}
+		else if constexpr (strategy == EQUALITY_STRATEGY::ES_HASHED_COUNTS) {
+			auto hash = [](const ElementT* element) { return std::hash<ElementT>{}(*element); };
+			auto equal = [](const ElementT* a, const ElementT* b) { return bool(*a == *b); };
+
+			std::unordered_map<const ElementT*, ptrdiff_t, decltype(hash), decltype(equal)> counts{ size, hash, equal };
+
+			for (const ElementT& element : lhs)
+				counts[&element]++;
+
+			for (const ElementT& element : rhs) {
+				auto it = counts.find(&element);
+
+				// more occurrences in `rhs` than in `lhs`
+				if (it == counts.end() || it->second-- == 0)
+					return false;
+			}
+
+			// the sizes are equal, so no element can be left with more occurrences in `lhs`
+			return true;
+		}
+		else if constexpr (strategy == EQUALITY_STRATEGY::ES_SORTED_REFERENCES) {
+			std::vector<const ElementT*> lhsElements;
+			std::vector<const ElementT*> rhsElements;
+			lhsElements.reserve(size);
+			rhsElements.reserve(size);
+
+			for (const ElementT& element : lhs)
+				lhsElements.push_back(&element);
+
+			for (const ElementT& element : rhs)
+				rhsElements.push_back(&element);
+
+			auto less = [](const ElementT* a, const ElementT* b) { return bool(*a < *b); };
+			parallelSortBoth(std::span{ lhsElements }, std::span{ rhsElements }, less, threadCount);
+
+			return std::ranges::equal(lhsElements, rhsElements, [](const ElementT* a, const ElementT* b) { return bool(*a == *b); });
+		}
+		else {
+			std::vector<bool> matched(size, false);
+
+			for (const ElementT& lhsElement : lhs) {
+				size_t index = 0;
+				bool found = false;
+
+				for (const ElementT& rhsElement : rhs) {
+					if (!matched[index] && lhsElement == rhsElement) {
+						matched[index] = found = true;
+						break;
+					}
+
+					index++;
+				}
+
+				if (!found)
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+}
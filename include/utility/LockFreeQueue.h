@@ -0,0 +1,185 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// CONSTANTS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The assumed size of a cache line, used to pad data that is written by different threads.
+	 * @note `std::hardware_destructive_interference_size` is not used because its value is not stable across compiler flags.
+	 */
+	inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief A bounded, lock-free, multi-producer multi-consumer FIFO queue.
+	 * @details The queue is a ring buffer of cells, each tagged with a sequence number that tells producers and consumers whether the cell is free to be written or ready to be read (Dmitry Vyukov's bounded MPMC queue). Pushing and popping cost a single CAS on the respective position counter in the uncontended case.
+	 * @note Although it supports many consumers, the intended use is many producers and a single consumer. Producers are still allowed to pop, which is how "drop the oldest element" overflow policies are implemented.
+	 * @tparam T The type of the queued elements. It must be nothrow move-constructible.
+	 */
+	template <typename T>
+	class BoundedQueue {
+		static_assert(std::is_nothrow_move_constructible_v<T>, "The elements of a BoundedQueue must be nothrow move-constructible.");
+
+		struct alignas(CACHE_LINE_SIZE) Cell {
+			std::atomic<size_t> sequence;
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			T* get() {
+				return std::launder(reinterpret_cast<T*>(storage));
+			}
+		};
+
+		std::unique_ptr<Cell[]> m_Cells;
+		const size_t m_Mask;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_EnqueuePos{ 0 };
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_DequeuePos{ 0 };
+
+		static size_t roundCapacity(size_t capacity) {
+			size_t res = 2;
+
+			while (res < capacity)
+				res <<= 1;
+
+			return res;
+		}
+
+	public:
+
+		/**
+		 * @brief Constructs an empty queue.
+		 * @param[in] capacity The minimum number of elements the queue can hold. It is rounded up to the next power of two (at least 2).
+		 */
+		explicit BoundedQueue(size_t capacity)
+			: m_Cells(new Cell[roundCapacity(capacity)]), m_Mask(roundCapacity(capacity) - 1)
+		{
+			for (size_t i = 0; i <= m_Mask; i++)
+				m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+		~BoundedQueue() {
+			T temp;
+			while (this->tryPop(temp));
+		}
+
+		/**
+		 * @brief Tries to push `value` at the back of the queue.
+		 * @param[in] value The value to be pushed. It is moved from only if the push succeeds.
+		 * @return `true` if the value has been pushed; `false` if the queue is full.
+		 */
+		bool tryPush(T&& value) {
+			Cell* cell;
+			size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+
+			while (true) {
+				cell = &m_Cells[pos & m_Mask];
+				const size_t seq = cell->sequence.load(std::memory_order_acquire);
+				const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+				// the cell is free: try to claim it
+				if (diff == 0) {
+					if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				// the cell still holds an element from the previous lap: the queue is full
+				else if (diff < 0)
+					return false;
+				// another producer claimed the cell
+				else
+					pos = m_EnqueuePos.load(std::memory_order_relaxed);
+			}
+
+			new (cell->storage) T(std::move(value));
+			cell->sequence.store(pos + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/**
+		 * @brief Tries to pop the element at the front of the queue.
+		 * @param[out] out The object the popped element will be move-assigned to.
+		 * @return `true` if an element has been popped; `false` if the queue is empty.
+		 */
+		bool tryPop(T& out) {
+			Cell* cell;
+			size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+
+			while (true) {
+				cell = &m_Cells[pos & m_Mask];
+				const size_t seq = cell->sequence.load(std::memory_order_acquire);
+				const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+				// the cell is ready: try to claim it
+				if (diff == 0) {
+					if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				// the cell has not been written yet: the queue is empty
+				else if (diff < 0)
+					return false;
+				// another consumer claimed the cell
+				else
+					pos = m_DequeuePos.load(std::memory_order_relaxed);
+			}
+
+			T* element = cell->get();
+			out = std::move(*element);
+			element->~T();
+			cell->sequence.store(pos + m_Mask + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/**
+		 * @return The number of elements the queue can hold.
+		 */
+		size_t capacity() const {
+			return m_Mask + 1;
+		}
+
+		/**
+		 * @return The number of pushes that have claimed a cell so far; the position in the queue of the next element to be pushed.
+		 */
+		size_t pushCount() const {
+			return m_EnqueuePos.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @return The number of elements popped so far; the position in the queue of the next element to be popped.
+		 */
+		size_t popCount() const {
+			return m_DequeuePos.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @return The number of elements in the queue. The value is only a snapshot if other threads are using the queue.
+		 */
+		size_t sizeApprox() const {
+			const size_t dequeuePos = m_DequeuePos.load(std::memory_order_acquire);
+			const size_t enqueuePos = m_EnqueuePos.load(std::memory_order_acquire);
+
+			return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+		}
+
+	};
+
+}
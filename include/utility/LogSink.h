@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Logger.h"
+
+// EXCEPTIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief An exception to be thrown by a sink that could not open or write its destination.
+	 */
+	struct LogSinkError : std::exception {
+
+		std::string msg{};
+
+		const char* what() const noexcept(true) override {
+			return "Log sink error.";
+		}
+
+		LogSinkError(const std::string& msg)
+			: msg(msg)
+		{
+		}
+	};
+
+}
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief A destination of logged records.
+	 * @details Sinks receive records in batches: a single record in synchronous mode, and up to a whole batch of the asynchronous writer otherwise. `write` may be called from several threads, so sinks must synchronize themselves.
+	 */
+	class LogSink {
+	public:
+
+		virtual ~LogSink() = default;
+
+		/**
+		 * @brief Writes a batch of records, in order.
+		 */
+		virtual void write(std::span<const LogRecord>) = 0;
+
+		/**
+		 * @brief Writes out anything the sink buffers.
+		 */
+		virtual void flush() {}
+
+	};
+
+	/**
+	 * @brief Writes records to the standard streams (see `Logger::getStream`), one write per stream and batch.
+	 */
+	class ConsoleSink : public LogSink {
+		const bool m_Color;
+		std::mutex m_Mutex;
+
+	public:
+
+		/**
+		 * @param[in] color Whether to decorate records with ANSI colors.
+		 */
+		explicit ConsoleSink(bool color = true)
+			: m_Color(color)
+		{
+		}
+
+		void write(std::span<const LogRecord>) override;
+		void flush() override;
+
+	};
+
+	/**
+	 * @brief The configuration of a `FileSink`.
+	 */
+	struct FileSinkOptions {
+		std::string path{};
+		size_t bufferSize = 1 << 20;						///< The size of the user-space buffer; records are written when it fills up or on `flush`.
+		size_t maxFileSize = 0;								///< Rotate once the file would exceed this size (0 disables size-based rotation).
+		std::chrono::seconds rotationInterval{ 0 };			///< Rotate once the file is this old (0 disables time-based rotation).
+		size_t maxBackups = 5;								///< The number of rotated files kept, named `path.1` (newest) to `path.N`.
+		bool append = true;									///< Open the file with `O_APPEND` instead of truncating it.
+		std::chrono::milliseconds syncInterval{ 0 };		///< Call `fdatasync` at most this often when writing out the buffer (0 never syncs).
+		size_t maxRetainedOnError = 0;						///< The number of bytes kept in the buffer, to be written again later, when a write fails (0 drops the buffer on failure).
+	};
+
+	/**
+	 * @brief Writes undecorated records to a file through a large user-space buffer, rotating the file by size and age.
+	 * @details Only the constructor throws. Failures to write (or to reopen the file after a rotation) are counted instead (see `getFailedWrites`), and the buffer is dropped or retained as `FileSinkOptions::maxRetainedOnError` decides, so that a full or failing disk never stops the logging thread.
+	 */
+	class FileSink : public LogSink {
+		using Clock = std::chrono::steady_clock;
+
+		const FileSinkOptions m_Options;
+		std::mutex m_Mutex;
+		std::string m_Buffer;
+		int m_Fd = -1;
+		size_t m_FileSize = 0;
+		Clock::time_point m_OpenedAt{};
+		Clock::time_point m_LastSync{};
+		std::atomic<size_t> m_FailedWrites = 0;
+		std::atomic<size_t> m_DroppedBytes = 0;
+
+		bool open(bool append);
+		void close();
+		void writeOut();
+		void rotate();
+
+	public:
+
+		explicit FileSink(const FileSinkOptions&);
+		FileSink(const FileSink&) = delete;
+		FileSink& operator=(const FileSink&) = delete;
+		~FileSink() override;
+
+		void write(std::span<const LogRecord>) override;
+		void flush() override;
+
+		/**
+		 * @return The number of times the buffer could not be written out.
+		 */
+		size_t getFailedWrites() const {
+			return m_FailedWrites.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return The number of bytes of records dropped after failed writes.
+		 */
+		size_t getDroppedBytes() const {
+			return m_DroppedBytes.load(std::memory_order_relaxed);
+		}
+
+	};
+
+	/**
+	 * @brief Keeps records in memory; intended for tests.
+	 */
+	class MemorySink : public LogSink {
+		mutable std::mutex m_Mutex;
+		std::vector<LogRecord> m_Records;
+
+	public:
+
+		void write(std::span<const LogRecord> records) override {
+			std::lock_guard lock{ m_Mutex };
+			m_Records.insert(m_Records.end(), records.begin(), records.end());
+		}
+
+		/**
+		 * @return A copy of the records written so far.
+		 */
+		std::vector<LogRecord> getRecords() const {
+			std::lock_guard lock{ m_Mutex };
+			return m_Records;
+		}
+
+		/**
+		 * @brief Discards the records written so far.
+		 */
+		void clear() {
+			std::lock_guard lock{ m_Mutex };
+			m_Records.clear();
+		}
+
+	};
+
+}
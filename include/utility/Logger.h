@@ -4,10 +4,35 @@
 #include <cstdarg>
 #include <format>
 #include <source_location>
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
 
+#include "fmt/format.h"
 #include "common.h"
+#include "RateLimiter.h"
+#include "Callsite.h"
+#include "FlightRecorder.h"
 //#define _TRACE
 
+/**
+ * @brief The least severe level that is compiled into the templated `Logger::log` API.
+ * @details Calls to `Logger::log<LEVEL>` and `Logger::logLimited<LEVEL>` with a less severe level compile to nothing: they are neither formatted nor kept by the `FlightRecorder`. Defaults to `LL_DEBUG` in debug builds and to `LL_INFO` otherwise. Define it (to the name of a `LOG_LEVEL` enumerator) before including this header to override it.
+ */
+#ifndef UTILITY_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define UTILITY_LOG_MIN_LEVEL LL_DEBUG
+#else
+#define UTILITY_LOG_MIN_LEVEL LL_INFO
+#endif
+#endif
+
 
 // EXCEPTIONS
 namespace m0st4fa {
@@ -27,6 +52,8 @@ namespace m0st4fa {
 
 // DECLARATIONS
 namespace m0st4fa {
+
+	class LogSink;
 	
 	enum class LOG_LEVEL {
 		LL_FATAL_ERROR,
@@ -42,6 +69,59 @@ namespace m0st4fa {
 
 		static const LoggerInfo LL_ERROR, LL_WARNING, LL_INFO, LL_DEBUG, LL_FATAL_ERROR;
 	};
+
+	/**
+	 * @brief The least severe level that is compiled into the templated `Logger::log` API (see `UTILITY_LOG_MIN_LEVEL`).
+	 */
+	inline constexpr LOG_LEVEL LOG_MIN_LEVEL = LOG_LEVEL::UTILITY_LOG_MIN_LEVEL;
+
+	/**
+	 * @brief A compile-time checked format string that also captures the location of the logging call.
+	 * @details Capturing the location here allows `Logger::log<LEVEL>` to be variadic while still defaulting the location to the caller's.
+	 * @tparam Args The types of the arguments to be formatted.
+	 */
+	template <typename... Args>
+	struct LogFormatString {
+		fmt::format_string<Args...> str;
+		std::source_location location;
+
+		template <typename S>
+			requires std::convertible_to<const S&, std::string_view>
+		consteval LogFormatString(const S& str, std::source_location location = std::source_location::current())
+			: str(str), location(location)
+		{
+		}
+	};
+
+	/**
+	 * @brief What an asynchronous logger does when its queue is full.
+	 */
+	enum class OVERFLOW_POLICY {
+		OP_BLOCK,			///< Wait until the writer thread makes room.
+		OP_DROP_NEWEST,		///< Discard the record being logged.
+		OP_DROP_OLDEST,		///< Discard the oldest queued record to make room for the new one.
+		OP_COUNT
+	};
+
+	/**
+	 * @brief The configuration of the asynchronous logging mode.
+	 */
+	struct AsyncLoggerOptions {
+		size_t queueCapacity = 8192;
+		size_t batchSize = 256;
+		OVERFLOW_POLICY overflowPolicy = OVERFLOW_POLICY::OP_BLOCK;
+	};
+
+	/**
+	 * @brief A message that has been logged but not yet written.
+	 * @details The message is kept undecorated; the ANSI colors and the level prefix are added by `Logger::format` when the record is written, which, in asynchronous mode, happens on the writer thread.
+	 */
+	struct LogRecord {
+		LOG_LEVEL level = LOG_LEVEL::LL_INFO;
+		std::string message{};
+		std::string location{};
+		std::chrono::steady_clock::time_point loggedAt{};	///< Set only while `LoggerMetrics` are enabled.
+	};
 	
 	class Logger {
 
@@ -57,12 +137,153 @@ namespace m0st4fa {
 			"DEBUG",
 		};
 
+		static inline std::atomic<LOG_LEVEL> s_Threshold{ LOG_LEVEL::LL_DEBUG };
+
+		static void write(LogRecord&&);
+
+		void logFormatted(LOG_LEVEL, std::string&&, std::source_location) const;
+		void logFormatted(LOG_LEVEL, std::string&&, const Callsite&) const;
+
+		static void logSuppressed(LOG_LEVEL, const char*, uint32_t, uint64_t);
+
 	public:
 
+		/**
+		 * @brief Logs a message formatted from `formatStr` and `args`.
+		 * @details Nothing is done unless `level` is compiled in (see `UTILITY_LOG_MIN_LEVEL`). The message is only formatted if `level` is also enabled at runtime (see `setLevel`). Otherwise, the call costs a branch or two and does not allocate; the arguments are taken by reference and only formatted (without allocating) if the `FlightRecorder` is enabled.
+		 * @tparam level The level of the message.
+		 * @param[in] formatStr The format string of the message. Its syntax is checked at compile time.
+		 * @param[in] args The arguments to be formatted.
+		 */
+		template <LOG_LEVEL level, typename... Args>
+		void log(LogFormatString<std::type_identity_t<Args>...> formatStr, Args&&... args) const {
+			static_assert(level < LOG_LEVEL::LL_LOG_LEVEL_COUNT, "Unknown log level.");
+
+			if constexpr (level <= LOG_MIN_LEVEL) {
+				if (isEnabled(level)) {
+					this->logFormatted(level, fmt::format(formatStr.str, std::forward<Args>(args)...), formatStr.location);
+					return;
+				}
+
+				// messages discarded at runtime are still kept by the flight recorder, formatted straight into its buffer
+				if (FlightRecorder::isEnabled())
+					FlightRecorder::record(level, formatStr.str, std::forward<Args>(args)...);
+			}
+
+		}
+
 		void log(const LoggerInfo&, const std::string&, std::source_location = std::source_location::current()) const;
 		
 		void logDebug(const std::string&, std::source_location = std::source_location::current()) const;
 
+		/**
+		 * @brief Like the templated `log`, but for a callsite registered with `CallsiteRegistry` (see `UTILITY_LOG`).
+		 * @details Nothing is formatted if the callsite has been switched off, unless the `FlightRecorder` is enabled (as for a level disabled at runtime). Traced messages use the location the callsite rendered when it was registered.
+		 * @tparam level The level of the message.
+		 * @param[in] callsite The descriptor of the calling callsite.
+		 * @param[in] formatStr The format string of the message.
+		 * @param[in] args The arguments to be formatted.
+		 */
+		template <LOG_LEVEL level, typename... Args>
+		void log(const Callsite& callsite, fmt::format_string<Args...> formatStr, Args&&... args) const {
+			static_assert(level < LOG_LEVEL::LL_LOG_LEVEL_COUNT, "Unknown log level.");
+
+			if constexpr (level <= LOG_MIN_LEVEL) {
+				if (isEnabled(level) && callsite.isEnabled()) {
+					this->logFormatted(level, fmt::format(formatStr, std::forward<Args>(args)...), callsite);
+					return;
+				}
+
+				if (FlightRecorder::isEnabled())
+					FlightRecorder::record(level, formatStr, std::forward<Args>(args)...);
+			}
+
+		}
+
+		/**
+		 * @brief Like the templated `log`, but limited to the rate `limit` for the callsite of the call.
+		 * @details The limiter of the callsite is found by its source location with a lock-free lookup, and the decision costs an atomic increment (sampling) and a CAS (token bucket), both before anything is formatted. When a message passes after others have been suppressed, a summary record with the number of suppressed messages is logged before it. Messages suppressed or disabled at runtime are still kept by the `FlightRecorder`, if it is enabled.
+		 * @tparam level The level of the message.
+		 * @param[in] limit The sampling rate and token bucket of the callsite.
+		 * @param[in] formatStr The format string of the message.
+		 * @param[in] args The arguments to be formatted.
+		 */
+		template <LOG_LEVEL level, typename... Args>
+		void logLimited(const RateLimit& limit, LogFormatString<std::type_identity_t<Args>...> formatStr, Args&&... args) const {
+			static_assert(level < LOG_LEVEL::LL_LOG_LEVEL_COUNT, "Unknown log level.");
+
+			if constexpr (level <= LOG_MIN_LEVEL) {
+				uint64_t suppressed;
+
+				if (!isEnabled(level) || !RateLimiter::get(formatStr.location, level).tryAcquire(limit, suppressed)) {
+					if (FlightRecorder::isEnabled())
+						FlightRecorder::record(level, formatStr.str, std::forward<Args>(args)...);
+
+					return;
+				}
+
+				if (suppressed)
+					logSuppressed(level, formatStr.location.file_name(), formatStr.location.line(), suppressed);
+
+				this->logFormatted(level, fmt::format(formatStr.str, std::forward<Args>(args)...), formatStr.location);
+			}
+
+		}
+
+		void log(const LoggerInfo&, const std::string&, const RateLimit&, std::source_location = std::source_location::current()) const;
+
+		static void reportSuppressed();
+
+		static std::string format(const LogRecord&, bool color = true);
+		static std::pmr::string format(const LogRecord&, std::pmr::memory_resource*, bool color = true);
+
+		/**
+		 * @return The name of `level` as it appears in logged messages.
+		 */
+		static const char* getLevelString(LOG_LEVEL level) {
+			if (level < LOG_LEVEL::LL_FATAL_ERROR || level >= LOG_LEVEL::LL_LOG_LEVEL_COUNT)
+				throw UnknownLogLevel{};
+
+			return (const char*)LOG_LEVEL_STRING[static_cast<int>(level)];
+		}
+
+		static std::ostream& getStream(LOG_LEVEL);
+
+		static void enableAsync(const AsyncLoggerOptions& = {});
+		static void disableAsync();
+		static bool isAsync();
+		static void flush();
+		static size_t droppedCount();
+
+		static void writeToSinks(std::span<const LogRecord>);
+		static void addSink(std::shared_ptr<LogSink>);
+		static void removeSink(const std::shared_ptr<LogSink>&);
+		static void setSinks(std::vector<std::shared_ptr<LogSink>>);
+		static void resetSinks();
+		static std::vector<std::shared_ptr<LogSink>> getSinks();
+
+		/**
+		 * @brief Sets the runtime threshold: messages less severe than `level` are discarded.
+		 * @param[in] level The least severe level to be logged.
+		 */
+		static void setLevel(LOG_LEVEL level) {
+			s_Threshold.store(level, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return The least severe level currently logged.
+		 */
+		static LOG_LEVEL getLevel() {
+			return s_Threshold.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return `true` if messages of `level` are currently logged; `false` otherwise.
+		 */
+		static bool isEnabled(LOG_LEVEL level) {
+			return level <= s_Threshold.load(std::memory_order_relaxed);
+		}
+
 		inline std::string getCurrSourceLocation(std::source_location location = std::source_location::current()) const {
 			std::string messageStr;
 			messageStr += std::string("\nFile Name: ") + location.file_name() + std::string("\n");
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "LockFreeQueue.h"
+#include "Logger.h"
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief A histogram of latencies (in nanoseconds) with logarithmic buckets, in the style of HdrHistogram.
+	 * @details Every power of two is split into `2^SUB_BUCKET_BITS` linear sub-buckets, so the relative error of a recorded value is at most 1/8, whatever its magnitude, and the whole 64-bit range fits in a few hundred buckets.
+	 */
+	struct LatencyHistogram {
+		static constexpr size_t SUB_BUCKET_BITS = 3;
+		static constexpr size_t SUB_BUCKET_COUNT = size_t{ 1 } << SUB_BUCKET_BITS;
+		static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+		std::array<uint64_t, BUCKET_COUNT> counts{};
+
+		/**
+		 * @return The index of the bucket `value` falls in.
+		 */
+		static constexpr size_t getBucketIndex(uint64_t value) {
+			if (value < SUB_BUCKET_COUNT)
+				return (size_t)value;
+
+			const size_t msb = (size_t)std::bit_width(value) - 1;
+			const size_t sub = (size_t)(value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+
+			return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + sub;
+		}
+
+		/**
+		 * @return The greatest value that falls in the bucket `index`.
+		 */
+		static constexpr uint64_t getBucketUpperBound(size_t index) {
+			if (index < SUB_BUCKET_COUNT)
+				return index;
+
+			const size_t msb = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+			const uint64_t sub = index % SUB_BUCKET_COUNT;
+			const uint64_t lower = (SUB_BUCKET_COUNT + sub) << (msb - SUB_BUCKET_BITS);
+
+			return lower + (uint64_t{ 1 } << (msb - SUB_BUCKET_BITS)) - 1;
+		}
+
+		uint64_t getCount() const;
+		uint64_t getPercentile(double) const;
+		uint64_t getMax() const;
+
+		LatencyHistogram& operator+=(const LatencyHistogram&);
+		LatencyHistogram& operator-=(const LatencyHistogram&);
+	};
+
+	/**
+	 * @brief The counters of every `Logger`, merged across threads at the time `LoggerMetrics::getSnapshot` was called.
+	 * @note Counters only grow; subtract two snapshots to measure an interval (e.g., a load test).
+	 */
+	struct LoggerMetricsSnapshot {
+		static constexpr size_t LEVEL_COUNT = (size_t)LOG_LEVEL::LL_LOG_LEVEL_COUNT;
+
+		std::array<uint64_t, LEVEL_COUNT> messages{};				///< Records written to the sinks.
+		std::array<uint64_t, LEVEL_COUNT> bytes{};					///< Message and location bytes of the written records.
+		std::array<uint64_t, LEVEL_COUNT> dropped{};				///< Records dropped by the overflow policy of the asynchronous mode.
+		std::array<LatencyHistogram, LEVEL_COUNT> latency{};		///< Time from logging a record to its being written by every sink.
+
+		LoggerMetricsSnapshot& operator-=(const LoggerMetricsSnapshot&);
+	};
+
+	LoggerMetricsSnapshot operator-(LoggerMetricsSnapshot, const LoggerMetricsSnapshot&);
+
+	std::string toString(const LoggerMetricsSnapshot&);
+
+	/**
+	 * @brief The self-instrumentation of the logger.
+	 * @details Each thread updates its own cache-line-aligned block of counters with plain (uncontended) stores; reading merges the blocks of live threads with the totals of exited ones. Nothing is collected (and no clock is read) unless metrics are enabled.
+	 */
+	class LoggerMetrics {
+		static inline std::atomic<bool> s_Enabled{ false };
+
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Enables or disables the collection of metrics.
+		 */
+		static void setEnabled(bool enabled) {
+			s_Enabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return `true` if metrics are being collected; `false` otherwise.
+		 */
+		static bool isEnabled() {
+			return s_Enabled.load(std::memory_order_relaxed);
+		}
+
+		static void recordWritten(const LogRecord&, Clock::time_point);
+		static void recordDropped(LOG_LEVEL);
+		static LoggerMetricsSnapshot getSnapshot();
+
+	};
+
+}
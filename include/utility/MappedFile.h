@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// EXCEPTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief An exception to be thrown when a file cannot be opened or read.
+	 */
+	struct FileError : std::exception {
+
+		std::string msg{};
+
+		const char* what() const noexcept(true) override {
+			return "File error.";
+		}
+
+		FileError(const std::string& msg)
+			: msg(msg)
+		{
+		}
+	};
+
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief A read-only view of the contents of a file, mapped into memory with `mmap`, so that it is paged in as it is read and never copied.
+	 * @details On Windows, the file is read into memory instead.
+	 */
+	class MappedFile {
+		const char* m_Data = nullptr;
+		size_t m_Size = 0;
+		std::string m_Contents;		// the contents, where the file is read instead of mapped
+
+	public:
+
+		explicit MappedFile(const std::string&);
+		MappedFile(MappedFile&&) noexcept;
+		MappedFile& operator=(MappedFile&&) noexcept;
+		~MappedFile();
+
+		std::string_view view() const {
+			return { m_Data, m_Size };
+		}
+
+		size_t size() const {
+			return m_Size;
+		}
+
+	};
+
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "IterableEquality.h"
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief A view of a range whose elements are known to be sorted (in ascending order), so that `isIn` searches it with a binary search.
+	 * @details The view refers to the range, which must outlive it and stay sorted. It is created with `asSorted`.
+	 * @tparam RangeT The type of the sorted range.
+	 */
+	template <std::ranges::forward_range RangeT>
+	class SortedRange : public std::ranges::view_interface<SortedRange<RangeT>> {
+		const RangeT* m_Range = nullptr;
+
+	public:
+
+		SortedRange() = default;
+
+		explicit SortedRange(const RangeT& range)
+			: m_Range(&range)
+		{
+		}
+
+		auto begin() const {
+			return std::ranges::begin(*m_Range);
+		}
+
+		auto end() const {
+			return std::ranges::end(*m_Range);
+		}
+
+		auto size() const requires std::ranges::sized_range<const RangeT> {
+			return std::ranges::size(*m_Range);
+		}
+
+		const RangeT& base() const {
+			return *m_Range;
+		}
+
+	};
+
+	/**
+	 * @brief The number of needles from which `isInAny` indexes the haystack (see `MembershipIndex`) instead of searching it once per needle.
+	 */
+	inline constexpr size_t MIN_NEEDLES_FOR_INDEX = 16;
+
+	size_t findValue(std::span<const uint8_t>, uint8_t);
+	size_t findValue(std::span<const uint16_t>, uint16_t);
+	size_t findValue(std::span<const uint32_t>, uint32_t);
+	size_t findValue(std::span<const uint64_t>, uint64_t);
+	size_t findValue(std::span<const float>, float);
+	size_t findValue(std::span<const double>, double);
+
+}
+
+// CONCEPTS
+namespace m0st4fa::utility {
+
+	template <typename T>
+	inline constexpr bool IS_SORTED_RANGE = false;
+
+	template <typename RangeT>
+	inline constexpr bool IS_SORTED_RANGE<SortedRange<RangeT>> = true;
+
+	/**
+	 * @brief Checks whether `T` is a range tagged as sorted (see `asSorted`).
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept IsSortedRange = IS_SORTED_RANGE<T>;
+
+	/**
+	 * @brief Checks whether an iterable of type `IterableT` can look up an element of type `ElementT` with its own `contains` method.
+	 */
+	template <typename IterableT, typename ElementT>
+	concept ContainsElement = requires (const IterableT & iterable, const ElementT & element) {
+		{ iterable.contains(element) } -> std::convertible_to<bool>;
+	};
+
+	/**
+	 * @brief Checks whether an iterable of type `IterableT` can look up an element of type `ElementT` with its own `find` method, returning an iterator (as associative containers do).
+	 */
+	template <typename IterableT, typename ElementT>
+	concept FindsElement = requires (const IterableT & iterable, const ElementT & element) {
+		{ iterable.find(element) } -> std::same_as<std::ranges::iterator_t<const IterableT>>;
+	};
+
+	template <typename T>
+	inline constexpr bool IS_SEARCHABLE_VALUE = (std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t)) || std::same_as<T, float> || std::same_as<T, double>;
+
+	/**
+	 * @brief Checks whether `T` is a contiguous range of integers (other than `bool`) or floating-point numbers of up to 64 bits, which `findValue` can search.
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept ContiguousArithmeticRange = std::ranges::contiguous_range<const T> && std::ranges::sized_range<const T> && IS_SEARCHABLE_VALUE<std::ranges::range_value_t<T>>;
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Tags a range as sorted, so that `isIn` (and `isInAny`) search it with a binary search.
+	 * @attention The range must be sorted in ascending order, by `<`, and must outlive the returned view.
+	 * @param[in] range The sorted range.
+	 * @return A view of `range`.
+	 */
+	template <std::ranges::forward_range RangeT>
+	SortedRange<RangeT> asSorted(const RangeT& range) {
+		return SortedRange<RangeT>{ range };
+	}
+
+	/**
+	 * @brief Finds the first occurrence of `value` among integers of any type, searched as the unsigned integers of the same size (see `findValue` for the unsigned ones).
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t))
+	size_t findValue(std::span<const T> values, T value) {
+		using UnsignedT = std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+		// integers of the same size are equal iff their bits are
+		return findValue(std::span<const UnsignedT>{ reinterpret_cast<const UnsignedT*>(values.data()), values.size() }, (UnsignedT)value);
+	}
+
+	/**
+	 * @brief Checks whether an element is in a contiguous range of numbers (see `findValue`), converting it to the type of the numbers only if it keeps its value.
+	 * @return `true` or `false`; or nothing if the element cannot be converted (and must be compared by "==" instead).
+	 */
+	template <ContiguousArithmeticRange RangeT, typename ElementT>
+	std::optional<bool> findArithmetic(const RangeT& range, const ElementT& element) {
+		using ValueT = std::ranges::range_value_t<RangeT>;
+
+		const std::span<const ValueT> values{ std::ranges::data(range), std::ranges::size(range) };
+
+		if constexpr (std::same_as<ElementT, ValueT>)
+			return findValue(values, element) != values.size();
+		else if constexpr (std::integral<ElementT> && std::integral<ValueT> && !std::same_as<ElementT, bool>) {
+			if (std::in_range<ValueT>(element))
+				return findValue(values, (ValueT)element) != values.size();
+		}
+
+		return std::nullopt;
+	}
+
+	/**
+	 * @brief An index of the elements of an iterable, to look up many elements in it in O(1) each (see `isInAny`).
+	 * @details Integers within a range of no more than 64 values per element are indexed by a bitset over that range; other elements are copied into a hash set.
+	 * @tparam T The type of the elements.
+	 */
+	template <typename T>
+		requires (std::integral<T> || Hashable<T>)
+	class MembershipIndex {
+		std::vector<uint64_t> m_Bits;
+		std::unordered_set<T> m_Elements;
+		T m_Min{};
+		T m_Max{};
+		bool m_Dense = false;
+
+	public:
+
+		/**
+		 * @param[in] iterable The iterable whose elements are indexed.
+		 */
+		template <std::ranges::input_range IterableT>
+		explicit MembershipIndex(const IterableT& iterable) {
+			if constexpr (std::integral<T>) {
+				size_t size = 0;
+
+				for (const T& element : iterable) {
+					if (!size || element < m_Min)
+						m_Min = element;
+
+					if (!size || element > m_Max)
+						m_Max = element;
+
+					size++;
+				}
+
+				// the bitset takes no more memory than a hash set (of 8 bytes per element at least)
+				const uint64_t span = uint64_t(m_Max) - uint64_t(m_Min);
+				m_Dense = size && span / 64 < size;
+
+				if (m_Dense) {
+					m_Bits.assign(size_t(span / 64 + 1), 0);
+
+					for (const T& element : iterable) {
+						const uint64_t bit = uint64_t(element) - uint64_t(m_Min);
+						m_Bits[bit / 64] |= uint64_t(1) << (bit % 64);
+					}
+
+					return;
+				}
+			}
+
+			for (const T& element : iterable)
+				m_Elements.insert(element);
+		}
+
+		/**
+		 * @return Whether the bitset is used (rather than the hash set).
+		 */
+		bool isDense() const {
+			return m_Dense;
+		}
+
+		bool contains(const T& element) const {
+			if constexpr (std::integral<T>)
+				if (m_Dense) {
+					if (element < m_Min || element > m_Max)
+						return false;
+
+					const uint64_t bit = uint64_t(element) - uint64_t(m_Min);
+					return m_Bits[bit / 64] >> (bit % 64) & 1;
+				}
+
+			return m_Elements.contains(element);
+		}
+
+	};
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "TextWriter.h"
+
+// CONCEPTS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Checks whether `T` is a number written by `appendNumber`: an integer (but not `bool`) or a floating-point number.
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept AppendableNumber = (std::integral<T> && !std::same_as<T, bool>) || std::floating_point<T>;
+
+}
+
+// NUMBER FORMATTING
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The maximum length of a number of type `T` written by `appendNumber`.
+	 */
+	template <AppendableNumber T>
+	inline constexpr size_t MAX_NUMBER_SIZE = std::integral<T> ? std::numeric_limits<T>::digits10 + 2 : 64;
+
+	/**
+	 * @brief "00" to "99", so that integers are written two digits at a time.
+	 */
+	inline constexpr char DIGIT_PAIRS[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	/**
+	 * @brief Counts the decimal digits of an integer, including its sign.
+	 * @details The count is derived from the bit width of the magnitude and corrected with a single comparison against a power of 10.
+	 * @tparam T The type of the integer.
+	 * @param[in] value The integer.
+	 * @return The length of the decimal representation of `value`.
+	 */
+	template <std::integral T>
+	constexpr size_t countDigits(T value) {
+		using UnsignedT = std::make_unsigned_t<T>;
+
+		constexpr std::array<uint64_t, 20> POWERS_OF_10 = [] {
+			std::array<uint64_t, 20> powers{ 1 };
+
+			for (size_t i = 1; i < powers.size(); i++)
+				powers[i] = powers[i - 1] * 10;
+
+			return powers;
+			}();
+
+		size_t sign = 0;
+		UnsignedT magnitude = (UnsignedT)value;
+
+		if constexpr (std::is_signed_v<T>)
+			if (value < 0) {
+				magnitude = UnsignedT(0) - magnitude;
+				sign = 1;
+			}
+
+		// `| 1` does not change the count (powers of 10 are even) and makes 0 count as 1 digit
+		const uint64_t bits = (uint64_t)magnitude | 1;
+		const size_t guess = (size_t)(std::bit_width(bits) * 1233) >> 12;
+
+		return sign + guess - (bits < POWERS_OF_10[guess]) + 1;
+	}
+
+	/**
+	 * @brief Writes an integer in decimal, two digits at a time, from its last digit backwards.
+	 * @param[out] out Where to write; there must be room for `MAX_NUMBER_SIZE<T>` characters.
+	 * @param[in] value The integer.
+	 * @return The end of the written characters.
+	 */
+	template <std::integral T>
+		requires AppendableNumber<T>
+	char* appendNumber(char* out, T value) {
+		using UnsignedT = std::make_unsigned_t<T>;
+
+		UnsignedT magnitude = (UnsignedT)value;
+
+		if constexpr (std::is_signed_v<T>)
+			if (value < 0) {
+				magnitude = UnsignedT(0) - magnitude;
+				*out++ = '-';
+			}
+
+		char* const end = out + countDigits(magnitude);
+		char* p = end;
+
+		while (magnitude >= 100) {
+			const size_t pair = (size_t)(magnitude % 100) * 2;
+			magnitude /= 100;
+
+			*--p = DIGIT_PAIRS[pair + 1];
+			*--p = DIGIT_PAIRS[pair];
+		}
+
+		if (magnitude >= 10) {
+			*--p = DIGIT_PAIRS[magnitude * 2 + 1];
+			*--p = DIGIT_PAIRS[magnitude * 2];
+		}
+		else
+			*--p = char('0' + magnitude);
+
+		return end;
+	}
+
+	/**
+	 * @brief Writes a floating-point number in its shortest form that reads back as the same number (`std::to_chars` without a format).
+	 * @param[out] out Where to write; there must be room for `MAX_NUMBER_SIZE<T>` characters.
+	 * @param[in] value The number.
+	 * @return The end of the written characters.
+	 */
+	template <std::floating_point T>
+	char* appendNumber(char* out, T value) {
+		return std::to_chars(out, out + MAX_NUMBER_SIZE<T>, value).ptr;
+	}
+
+	/**
+	 * @brief Appends a number to a writer (see `appendNumber(char*, T)`), through a stack buffer.
+	 * @param[out] writer The writer to append to.
+	 * @param[in] value The number.
+	 * @return `writer`.
+	 */
+	template <TextWriter W, AppendableNumber T>
+	W& appendNumber(W& writer, T value) {
+		char buffer[MAX_NUMBER_SIZE<T>];
+		writer.append(std::string_view{ buffer, appendNumber(buffer, value) });
+
+		return writer;
+	}
+
+	/**
+	 * @brief Appends a floating-point number in fixed notation with `precision` decimals, as `printf("%.*f")` (and, for a precision of 6, `std::to_string`) would write it.
+	 * @param[out] writer The writer to append to.
+	 * @param[in] value The number.
+	 * @param[in] precision The number of decimals.
+	 * @return `writer`.
+	 */
+	template <TextWriter W, std::floating_point T>
+	W& appendFixed(W& writer, T value, int precision = 6) {
+		// enough for any `double` with a precision of up to 32; larger numbers take the slow path
+		char buffer[352];
+		const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+
+		if (result.ec == std::errc{}) {
+			writer.append(std::string_view{ buffer, result.ptr });
+			return writer;
+		}
+
+		// the integral digits, the sign, the point and the decimals
+		std::string text((size_t)std::numeric_limits<T>::max_exponent10 + (size_t)std::max(precision, 0) + 4, '\0');
+		writer.append(std::string_view{ text.data(), std::to_chars(text.data(), text.data() + text.size(), value, std::chars_format::fixed, precision).ptr });
+
+		return writer;
+	}
+
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "Expected.h"
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Why `parseInteger` could not parse an integer.
+	 */
+	enum class PARSE_ERROR {
+		PE_NONE,
+		PE_NO_DIGITS,		///< The text does not start with an (optionally signed) integer.
+		PE_OVERFLOW,		///< The integer does not fit into the requested type.
+		PE_INVALID_BASE,	///< The base is not 2, 8, 10 or 16.
+		PE_INVALID_FIELD,	///< A delimited field holds more than an integer (see `parseIntegers`).
+		PE_COUNT
+	};
+
+	/**
+	 * @brief The result of `parseInteger`.
+	 * @tparam T The type of the parsed integer.
+	 */
+	template <std::integral T>
+	struct ParseResult {
+		T value = 0;									///< The parsed integer; 0 on error.
+		size_t consumed = 0;							///< The number of characters of the integer, including its sign; on overflow, the characters of the whole (too long) integer.
+		PARSE_ERROR error = PARSE_ERROR::PE_NONE;
+
+		explicit operator bool() const {
+			return error == PARSE_ERROR::PE_NONE;
+		}
+	};
+
+	/**
+	 * @brief Why and where a conversion failed, as returned by the non-throwing conversions (such as `tryParseInteger` and `tryToInteger`).
+	 */
+	struct ConversionFailure {
+		PARSE_ERROR error = PARSE_ERROR::PE_NONE;
+		size_t offset = 0;		///< The offset of the failure within the converted text.
+	};
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The value of every character as a digit of bases up to 16, or 0xFF if it is not one.
+	 */
+	inline constexpr std::array<uint8_t, 256> DIGIT_VALUES = [] {
+		std::array<uint8_t, 256> values{};
+		values.fill(0xFF);
+
+		for (int c = '0'; c <= '9'; c++)
+			values[c] = uint8_t(c - '0');
+
+		for (int c = 'a'; c <= 'f'; c++)
+			values[c] = values[c - 'a' + 'A'] = uint8_t(c - 'a' + 10);
+
+		return values;
+		}();
+
+	/**
+	 * @brief Checks whether the 8 characters packed (in memory order) into `chunk` are all decimal digits.
+	 */
+	constexpr bool isEightDigits(uint64_t chunk) {
+		// every byte must be 0x30 to 0x39: its high nibble is 3, and adding 6 does not carry into it
+		return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+	}
+
+	/**
+	 * @brief Converts 8 decimal digits packed (in memory order, on a little-endian machine) into `chunk`, with three multiplications instead of eight.
+	 * @details Adjacent digits are combined into pairs, pairs into quadruplets and quadruplets into the result, each step handling all the lanes of the word at once.
+	 */
+	constexpr uint32_t parseEightDigits(uint64_t chunk) {
+		chunk -= 0x3030303030303030;
+		chunk = (chunk * 10) + (chunk >> 8);
+		chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+
+		return (uint32_t)chunk;
+	}
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+	/**
+	 * @brief Counts the decimal digits at the beginning of 16 characters.
+	 * @param[in] text 16 readable characters.
+	 * @return The number of leading digits (16 if all of them are).
+	 */
+	inline size_t countSixteenDigits(const char* text) {
+		const __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)text), _mm_set1_epi8('0'));
+		// unsigned `digit <= 9`: the minimum of the digit and 9 is the digit itself
+		const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits));
+
+		return (size_t)std::countr_one((unsigned)mask & 0xFFFF);
+	}
+
+	/**
+	 * @brief Converts 16 decimal digits with SSE4.1: pairs, quadruplets and octuplets are combined with multiply-adds across the lanes.
+	 * @param[in] text 16 decimal digits.
+	 */
+	inline uint64_t parseSixteenDigits(const char* text) {
+		const __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)text), _mm_set1_epi8('0'));
+		const __m128i pairs = _mm_maddubs_epi16(digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+		const __m128i quadruplets = _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+		const __m128i packed = _mm_packus_epi32(quadruplets, quadruplets);
+		const __m128i octuplets = _mm_madd_epi16(packed, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+
+		return (uint64_t)(uint32_t)_mm_cvtsi128_si32(octuplets) * 100000000 + (uint32_t)_mm_extract_epi32(octuplets, 1);
+	}
+#endif
+
+	/**
+	 * @brief Parses the decimal magnitude of an integer: 16 digits at a time with SSE4.1 (where available), 8 digits at a time with SWAR (on little-endian machines), and one at a time otherwise.
+	 * @param[in,out] p The first digit; set past the last one.
+	 * @param[in] end The end of the text.
+	 * @param[out] magnitude The parsed magnitude.
+	 * @return `false` if the magnitude does not fit into 64 bits.
+	 */
+	inline bool parseDecimalMagnitude(const char*& p, const char* end, uint64_t& magnitude) {
+		// leading zeros do not count towards the 20 digits of a 64-bit integer
+		while (p < end && *p == '0')
+			p++;
+
+		const char* const significant = p;
+		uint64_t value = 0;
+
+#if defined(__SSE4_1__) || defined(__AVX2__)
+		if (end - p >= 16) {
+			const size_t count = countSixteenDigits(p);
+
+			if (count == 16) {
+				value = parseSixteenDigits(p);
+				p += 16;
+			}
+			else if (count >= 8) {
+				uint64_t chunk;
+				std::memcpy(&chunk, p, 8);
+				value = parseEightDigits(chunk);
+				p += 8;
+			}
+		}
+#endif
+
+		if constexpr (std::endian::native == std::endian::little)
+			// at most 16 digits, so that the value cannot overflow
+			while (end - p >= 8 && p - significant <= 8) {
+				uint64_t chunk;
+				std::memcpy(&chunk, p, 8);
+
+				if (!isEightDigits(chunk))
+					break;
+
+				value = value * 100000000 + parseEightDigits(chunk);
+				p += 8;
+			}
+
+		// any 19 digits fit into 64 bits
+		while (p < end && p - significant < 19 && (unsigned char)(*p - '0') <= 9)
+			value = value * 10 + uint64_t(*p++ - '0');
+
+		bool fits = true;
+
+		// the 20th digit may overflow, and any further one does
+		if (p < end && (unsigned char)(*p - '0') <= 9) {
+			const uint64_t digit = uint64_t(*p++ - '0');
+			fits = value <= (std::numeric_limits<uint64_t>::max() - digit) / 10;
+			value = value * 10 + digit;
+
+			for (; p < end && (unsigned char)(*p - '0') <= 9; p++)
+				fits = false;
+		}
+
+		magnitude = value;
+		return fits;
+	}
+
+	/**
+	 * @brief Parses the magnitude of an integer in base 2, 8 or 16, a digit (of `bitsPerDigit` bits) at a time.
+	 * @return `false` if the magnitude does not fit into 64 bits.
+	 */
+	inline bool parseBinaryMagnitude(const char*& p, const char* end, unsigned bitsPerDigit, uint64_t& magnitude) {
+		const unsigned base = 1u << bitsPerDigit;
+
+		uint64_t value = 0;
+		bool fits = true;
+
+		for (; p < end; p++) {
+			const unsigned digit = DIGIT_VALUES[(unsigned char)*p];
+
+			if (digit >= base)
+				break;
+
+			// the digit would shift set bits out of the value
+			fits &= (value >> (64 - bitsPerDigit)) == 0;
+			value = value << bitsPerDigit | digit;
+		}
+
+		magnitude = value;
+		return fits;
+	}
+
+	/**
+	 * @brief Parses an integer at the beginning of `text`, in the way of `std::from_chars`: an optional sign ('-' only for signed types, '+' for any) followed by digits, with no prefix and no leading spaces.
+	 * @details Decimal integers are parsed several digits at a time (see `parseDecimalMagnitude`); the magnitude is accumulated in 64 bits and then checked against the range of `T`.
+	 * @tparam T The type of the integer: any integral type of up to 64 bits but `bool`.
+	 * @param[in] text The text to be parsed. Characters after the integer are ignored (see `ParseResult::consumed`).
+	 * @param[in] base 2, 8, 10 or 16. Hexadecimal digits may be lowercase or uppercase.
+	 * @return The integer, the number of characters it takes, and the error, if any.
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t))
+	ParseResult<T> parseInteger(std::string_view text, int base = 10) {
+		using UnsignedT = std::make_unsigned_t<T>;
+
+		const char* const begin = text.data();
+		const char* const end = begin + text.size();
+		const char* p = begin;
+
+		if (base != 2 && base != 8 && base != 10 && base != 16)
+			return { 0, 0, PARSE_ERROR::PE_INVALID_BASE };
+
+		bool negative = false;
+
+		if (p < end && (*p == '+' || (std::is_signed_v<T> && *p == '-')))
+			negative = *p++ == '-';
+
+		const char* const digits = p;
+		uint64_t magnitude = 0;
+		bool fits = true;
+
+		switch (base) {
+			case 10:
+				fits = parseDecimalMagnitude(p, end, magnitude);
+				break;
+			case 16:
+				fits = parseBinaryMagnitude(p, end, 4, magnitude);
+				break;
+			case 8:
+				fits = parseBinaryMagnitude(p, end, 3, magnitude);
+				break;
+			default:
+				fits = parseBinaryMagnitude(p, end, 1, magnitude);
+		}
+
+		if (p == digits)
+			return { 0, 0, PARSE_ERROR::PE_NO_DIGITS };
+
+		const size_t consumed = size_t(p - begin);
+
+		// the magnitude of the most negative value is one more than that of the maximum
+		const uint64_t limit = (uint64_t)std::numeric_limits<T>::max() + negative;
+
+		if (!fits || magnitude > limit)
+			return { 0, consumed, PARSE_ERROR::PE_OVERFLOW };
+
+		const UnsignedT value = negative ? UnsignedT(UnsignedT(0) - (UnsignedT)magnitude) : (UnsignedT)magnitude;
+
+		return { (T)value, consumed, PARSE_ERROR::PE_NONE };
+	}
+
+	/**
+	 * @brief Converts a text that holds exactly one integer (see `parseInteger` for its syntax), without throwing, logging or allocating.
+	 * @tparam T The type of the integer.
+	 * @param[in] text The text to be converted.
+	 * @param[in] base 2, 8, 10 or 16.
+	 * @return The integer; or the error and its offset: that of the integer on overflow, and that of the first character after the integer if there is one (`PE_INVALID_FIELD`).
+	 */
+	template <std::integral T>
+		requires (!std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t))
+	Expected<T, ConversionFailure> tryParseInteger(std::string_view text, int base = 10) {
+		const ParseResult<T> result = parseInteger<T>(text, base);
+
+		if (!result)
+			return Unexpected{ ConversionFailure{ result.error, 0 } };
+
+		if (result.consumed != text.size())
+			return Unexpected{ ConversionFailure{ PARSE_ERROR::PE_INVALID_FIELD, result.consumed } };
+
+		return result.value;
+	}
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The configuration of the parallel `toString` functions.
+	 */
+	struct ParallelFormatOptions {
+		size_t threadCount = 0;					///< The maximum number of threads, including the calling one (0 uses `std::thread::hardware_concurrency`).
+		size_t serialThreshold = 1 << 16;		///< Inputs with fewer elements (or rows, for 2D arrays) are formatted serially.
+		size_t minChunkSize = 1 << 14;			///< The minimum number of elements formatted by each thread.
+	};
+
+	/**
+	 * @brief Formats the chunks `[bounds[i], bounds[i + 1])` of an input on separate threads, each into its own buffer, and concatenates them between `prefix` and `suffix` into a presized string.
+	 * @details The first chunk is formatted on the calling thread. An exception thrown while formatting a chunk is rethrown once every thread is done.
+	 * @tparam Position The type of the chunk bounds (an iterator or an index).
+	 * @tparam FormatChunk A callable taking a `StringBuilder&`, the bounds of a chunk and its index.
+	 * @return The concatenated string.
+	 */
+	template <typename Position, typename FormatChunk>
+	std::string formatChunks(std::string_view prefix, std::string_view suffix, const std::vector<Position>& bounds, FormatChunk formatChunk) {
+		const size_t chunkCount = bounds.size() - 1;
+
+		std::vector<StringBuilder> chunks(chunkCount);
+		std::vector<std::exception_ptr> errors(chunkCount);
+		std::vector<std::thread> threads;
+
+		auto format = [&](size_t chunk) {
+			try {
+				formatChunk(chunks[chunk], bounds[chunk], bounds[chunk + 1], chunk);
+			}
+			catch (...) {
+				errors[chunk] = std::current_exception();
+			}
+			};
+
+		threads.reserve(chunkCount - 1);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++)
+			threads.emplace_back(format, chunk);
+
+		format(0);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (const std::exception_ptr& error : errors)
+			if (error)
+				std::rethrow_exception(error);
+
+		size_t size = prefix.size() + suffix.size();
+
+		for (const StringBuilder& chunk : chunks)
+			size += chunk.size();
+
+		std::string result;
+		result.reserve(size);
+		result += prefix;
+
+		for (const StringBuilder& chunk : chunks)
+			result += chunk.view();
+
+		return result += suffix;
+	}
+
+	/**
+	 * @brief Decides how many chunks an input of `size` elements is split into.
+	 * @return The number of chunks; 1 means the input should be formatted serially.
+	 */
+	inline size_t getChunkCount(size_t size, const ParallelFormatOptions& options) {
+		if (size < options.serialThreshold)
+			return 1;
+
+		const size_t threadCount = options.threadCount ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+		return std::clamp<size_t>(size / std::max<size_t>(options.minChunkSize, 1), 1, threadCount);
+	}
+
+	/**
+	 * @brief Splits a forward range into `chunkCount` contiguous chunks of (nearly) equal sizes.
+	 * @return The `chunkCount + 1` bounds of the chunks.
+	 */
+	template <std::ranges::forward_range R>
+	auto splitIntoChunks(const R& range, size_t size, size_t chunkCount) {
+		std::vector<std::ranges::iterator_t<const R>> bounds;
+		bounds.reserve(chunkCount + 1);
+
+		auto it = std::ranges::begin(range);
+		bounds.push_back(it);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+			std::ranges::advance(it, (std::ptrdiff_t)(size / chunkCount + (chunk <= size % chunkCount)));
+			bounds.push_back(it);
+		}
+
+		bounds.push_back(std::ranges::end(range));
+
+		return bounds;
+	}
+
+	/**
+	 * @brief Converts general iterables to strings, formatting chunks of them on several threads.
+	 * @details The output is identical to that of `toString`. Small inputs (see `ParallelFormatOptions::serialThreshold`) are simply passed to `toString`.
+	 * @tparam T The type of the iterable.
+	 * @param[in] iterable The iterable to be converted to a string.
+	 * @param[in] asList Whether or not to format the iterable graphically as a list. If set to false, each element appears on a new line.
+	 * @param[in] options When and how to split the work.
+	 * @return The string representation of the iterable.
+	 */
+	template <typename T>
+		requires std::ranges::forward_range<const T> && std::ranges::sized_range<const T> && (!IsMap<T>) && (!Is2DArray<T>)
+	std::string toStringParallel(const T& iterable, bool asList = true, const ParallelFormatOptions& options = {}) {
+		using ElementType = decltype(T{}.at(0));
+		using Iterator = std::ranges::iterator_t<const T>;
+
+		const size_t size = std::ranges::size(iterable);
+		const size_t chunkCount = getChunkCount(size, options);
+
+		if (chunkCount == 1)
+			return toString(iterable, asList);
+
+		const std::string_view separator = asList ? ", " : "\n";
+
+		return formatChunks("{ ", " }", splitIntoChunks(iterable, size, chunkCount), [separator](StringBuilder& builder, Iterator first, Iterator last, size_t chunk) {
+			size_t estimate = 0;
+
+			for (Iterator it = first; it != last; ++it)
+				estimate += estimateStringSize<ElementType>(*it) + separator.size();
+
+			builder.reserve(estimate);
+
+			// every chunk but the first one follows an element
+			for (Iterator it = first; it != last; ++it) {
+				if (it != first || chunk)
+					builder.append(separator);
+
+				appendString<ElementType>(builder, *it);
+			}
+			});
+	}
+
+	/**
+	 * @brief Converts a 2D array to a string, formatting chunks of its rows on several threads.
+	 * @details The output is identical to that of `toString`. Small arrays (see `ParallelFormatOptions::serialThreshold`, compared with the number of rows) are simply passed to `toString`.
+	 * @param[in] array The 2D array to be converted.
+	 * @param[in] asList Whether or not to format the array graphically as a list.
+	 * @param[in] options When and how to split the work.
+	 * @returns The string representation of `array`.
+	 */
+	template <NumConvertableToString T, size_t xdim, size_t ydim>
+	std::string toStringParallel(const std::array<std::array<T, ydim>, xdim>& array, bool asList = true, const ParallelFormatOptions& options = {}) {
+		const size_t chunkCount = getChunkCount(xdim, options);
+
+		if (chunkCount == 1)
+			return toString(array, asList);
+
+		std::vector<size_t> bounds;
+
+		for (size_t chunk = 0; chunk <= chunkCount; chunk++)
+			bounds.push_back(xdim * chunk / chunkCount);
+
+		return formatChunks("{ ", " }", bounds, [&array](StringBuilder& builder, size_t first, size_t last, size_t) {
+			for (size_t x = first; x < last; x++)
+				for (size_t y = 0; y < ydim; y++)
+					if (array[x][y]) {
+						builder.append('[');
+						appendNumber(builder, x);
+						builder.append("][");
+						appendNumber(builder, y);
+						builder.append("] = ");
+						appendFormatted(builder, array[x][y]);
+						builder.append('\n');
+					}
+			});
+	}
+
+	/**
+	 * @brief Converts a map to a string, formatting chunks of its pairs on several threads.
+	 * @details The output is identical to that of `toString`. Small maps (see `ParallelFormatOptions::serialThreshold`) are simply passed to `toString`.
+	 * @param[in] map The map to be converted to a string.
+	 * @param[in] options When and how to split the work.
+	 * @return The string representation of `map`.
+	 */
+	template<typename K, typename V>
+	std::string toStringParallel(const std::map<K, V>& map, const ParallelFormatOptions& options = {}) {
+		using Iterator = typename std::map<K, V>::const_iterator;
+
+		const size_t chunkCount = getChunkCount(map.size(), options);
+
+		if (chunkCount == 1)
+			return toString(map);
+
+		return formatChunks("", "", splitIntoChunks(map, map.size(), chunkCount), [](StringBuilder& builder, Iterator first, Iterator last, size_t) {
+			size_t estimate = 0;
+
+			for (Iterator it = first; it != last; ++it)
+				estimate += estimateFormattedSize(it->first) + estimateToStringSize(it->second) + 4;
+
+			builder.reserve(estimate);
+
+			for (Iterator it = first; it != last; ++it) {
+				appendFormatted(builder, it->first);
+				builder.append(" : ");
+				appendToString(builder, it->second);
+				builder.append('\n');
+			}
+			});
+	}
+
+}
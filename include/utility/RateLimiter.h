@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <source_location>
+
+#include "LockFreeQueue.h"
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	enum class LOG_LEVEL;
+
+	/**
+	 * @brief How often the messages of a single callsite may be logged.
+	 * @details Both limits apply: a message is first sampled (1 in `everyN`) and then has to take a token from a bucket refilled at `ratePerSecond` and holding at most `burst` tokens.
+	 */
+	struct RateLimit {
+		double ratePerSecond = 0;	///< The refill rate of the token bucket; 0 disables the bucket.
+		uint32_t burst = 1;			///< The capacity of the token bucket.
+		uint32_t everyN = 1;		///< Only every Nth message is considered; 1 disables sampling.
+	};
+
+	/**
+	 * @brief The rate limiting state of one callsite.
+	 * @details The token bucket is implemented as a generic cell rate algorithm: the whole bucket is a single "theoretical arrival time", so taking a token is a single CAS.
+	 */
+	struct alignas(utility::CACHE_LINE_SIZE) CallsiteLimiter {
+		std::atomic<uint64_t> key{ 0 };
+		std::atomic<int64_t> theoreticalArrival{ 0 };
+		std::atomic<uint64_t> count{ 0 };
+		std::atomic<uint64_t> suppressed{ 0 };
+
+		// describes the callsite in suppression summaries; written once by the thread that claimed the slot, and only read once `described` is set
+		std::atomic<const char*> fileName{ nullptr };
+		std::atomic<uint32_t> line{ 0 };
+		std::atomic<int> level{ 0 };
+		std::atomic<bool> described{ false };
+
+		bool tryAcquire(const RateLimit&, uint64_t& suppressedBefore);
+	};
+
+	/**
+	 * @brief A fixed-size, lock-free table of per-callsite limiters keyed by `std::source_location`.
+	 */
+	class RateLimiter {
+	public:
+
+		/**
+		 * @brief The number of distinct callsites that can be limited; further callsites share one limiter.
+		 */
+		static constexpr size_t CAPACITY = 1024;
+
+		static CallsiteLimiter& get(const std::source_location&, LOG_LEVEL);
+		static void forEachSuppressed(const std::function<void(LOG_LEVEL, const char*, uint32_t, uint64_t)>&);
+
+	};
+
+}
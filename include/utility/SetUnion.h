@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <bitset>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Membership.h"
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The result of inserting the elements of an iterable into another (see `insertAll` and `insertAndAssert`).
+	 * @details It converts to `true` iff at least one element has been inserted, so that it can be used where a `bool` was returned before.
+	 */
+	struct InsertResult {
+		size_t added = 0;		///< The number of elements inserted (that were not already in the iterable inserted into).
+
+		operator bool() const {
+			return added != 0;
+		}
+
+		InsertResult& operator+=(InsertResult other) {
+			added += other.added;
+			return *this;
+		}
+	};
+
+}
+
+// CONCEPTS
+namespace m0st4fa::utility {
+
+	template <typename T>
+	inline constexpr bool IS_LESS = false;
+
+	template <typename T>
+	inline constexpr bool IS_LESS<std::less<T>> = true;
+
+	template <typename T, typename Compare>
+	inline constexpr bool IS_SORTED_BY = false;
+
+	template <typename K, typename C, typename A, typename Compare>
+	inline constexpr bool IS_SORTED_BY<std::set<K, C, A>, Compare> = std::same_as<C, Compare> || (IS_LESS<C> && IS_LESS<Compare>);
+
+	template <typename RangeT, typename Compare>
+	inline constexpr bool IS_SORTED_BY<SortedRange<RangeT>, Compare> = IS_LESS<Compare>;
+
+	/**
+	 * @brief Checks whether the elements of an iterable of type `T` are sorted by `Compare` by construction (as those of a `std::set` or of a range tagged by `asSorted` are).
+	 * @details `std::less` of any type is assumed to order elements the same as `std::less<>`.
+	 * @tparam T The type of the iterable.
+	 * @tparam Compare The ordering.
+	 */
+	template <typename T, typename Compare>
+	concept SortedBy = IS_SORTED_BY<std::remove_cvref_t<T>, Compare>;
+
+}
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Passes an element of an iterable of type `FromT` on: moved if the iterable is an rvalue, copied otherwise.
+	 */
+	template <typename FromT, typename ElementT>
+	constexpr decltype(auto) forwardElement(ElementT& element) {
+		if constexpr (std::is_lvalue_reference_v<FromT>)
+			return static_cast<const ElementT&>(element);
+		else
+			return std::move(element);
+	}
+
+	/**
+	 * @brief Checks whether the elements of `from` are sorted by `compare`: at compile time if they are by construction (see `SortedBy`), and by a (linear) pass otherwise.
+	 */
+	template <typename FromT, typename Compare>
+	bool isSortedBy(const FromT& from, Compare compare) {
+		if constexpr (SortedBy<FromT, Compare>)
+			return true;
+		else if constexpr (std::ranges::forward_range<const FromT>)
+			return std::ranges::is_sorted(from, compare);
+		else
+			return false;
+	}
+
+	/**
+	 * @brief Merges a sorted iterable into a set in a single pass over both: the position of each element is found by walking the set forward, so that it is inserted with an exact hint, in amortized O(1).
+	 * @param[in] from The sorted elements to be inserted (moved if `from` is an rvalue). Duplicates are allowed.
+	 * @param[in,out] to The set into which the elements are inserted.
+	 * @return The number of elements inserted.
+	 */
+	template <typename K, typename C, typename A, typename FromT>
+	InsertResult mergeSorted(FromT&& from, std::set<K, C, A>& to) {
+		const C compare = to.key_comp();
+		auto hint = to.begin();
+		size_t added = 0;
+
+		for (auto&& element : from) {
+			while (hint != to.end() && compare(*hint, element))
+				++hint;
+
+			// already in the set (or inserted just before)
+			if (hint != to.end() && !compare(element, *hint))
+				continue;
+
+			hint = to.insert(hint, forwardElement<FromT>(element));
+			added++;
+		}
+
+		return { added };
+	}
+
+	/**
+	 * @brief Merges a set into another of the same type, moving its nodes (as `std::set::merge` does) in a single pass over both sets (see `mergeSorted`).
+	 * @details The elements that are already in `to` are left in `from`.
+	 */
+	template <typename K, typename C, typename A>
+	InsertResult mergeNodes(std::set<K, C, A>& from, std::set<K, C, A>& to) {
+		const C compare = to.key_comp();
+		auto hint = to.begin();
+		size_t added = 0;
+
+		for (auto it = from.begin(); it != from.end();) {
+			while (hint != to.end() && compare(*hint, *it))
+				++hint;
+
+			if (hint != to.end() && !compare(*it, *hint)) {
+				++it;
+				continue;
+			}
+
+			auto next = std::next(it);
+			hint = to.insert(hint, from.extract(it));
+			it = next;
+			added++;
+		}
+
+		return { added };
+	}
+
+	/**
+	 * @brief Checks whether inserting `fromSize` sorted elements into a set of `toSize` elements is faster with a single pass over both (see `mergeSorted`) than with a search of the set for each element.
+	 */
+	constexpr bool isMergeFaster(size_t fromSize, size_t toSize) {
+		return fromSize * (size_t)std::bit_width(toSize) >= toSize;
+	}
+
+	/**
+	 * @brief Inserts the elements of an iterable into a set, in O(n + m) if they are sorted by the order of the set and many enough (see `isMergeFaster`), and in O(m log(n + m)) otherwise.
+	 * @details The elements of an rvalue iterable are moved; the nodes of an rvalue set of the same type are moved without reallocation (see `mergeNodes`).
+	 * @param[in] from The elements to be inserted.
+	 * @param[in,out] to The set into which the elements are inserted.
+	 * @return The number of elements inserted.
+	 */
+	template <typename K, typename C, typename A, typename FromT>
+	InsertResult insertAll(FromT&& from, std::set<K, C, A>& to) {
+		constexpr bool sized = std::ranges::sized_range<const std::remove_cvref_t<FromT>>;
+
+		if constexpr (std::same_as<std::remove_cvref_t<FromT>, std::set<K, C, A>> && !std::is_lvalue_reference_v<FromT> && !std::is_const_v<std::remove_reference_t<FromT>>) {
+			if (&from == &to)
+				return {};
+
+			if (isMergeFaster(from.size(), to.size()))
+				return mergeNodes(from, to);
+
+			const size_t size = to.size();
+			to.merge(from);
+
+			return { to.size() - size };
+		}
+		else {
+			bool mergeFaster = true;
+
+			if constexpr (sized)
+				mergeFaster = isMergeFaster((size_t)std::ranges::size(from), to.size());
+
+			if (mergeFaster && isSortedBy(from, to.key_comp()))
+				return mergeSorted(std::forward<FromT>(from), to);
+
+			size_t added = 0;
+
+			for (auto&& element : from)
+				added += to.insert(forwardElement<FromT>(element)).second;
+
+			return { added };
+		}
+	}
+
+	/**
+	 * @brief Inserts the elements of an iterable into a flat set: a `std::vector` kept sorted (by `<`) and without duplicates, in O(n + m) for sorted elements and O(n + m log(m)) otherwise.
+	 * @details The new elements are appended (moved if `from` is an rvalue) and then merged with the old ones in place.
+	 * @param[in] from The elements to be inserted.
+	 * @param[in,out] to The sorted vector into which the elements are inserted.
+	 * @attention `to` must be sorted and hold no duplicates; it stays so.
+	 * @return The number of elements inserted.
+	 */
+	template <typename T, typename A, typename FromT>
+		requires (!std::same_as<T, bool>)
+	InsertResult insertAll(FromT&& from, std::vector<T, A>& to) {
+		if (static_cast<const void*>(&from) == static_cast<const void*>(&to))
+			return {};
+
+		if (!isSortedBy(from, std::less<>{})) {
+			std::vector<T> sorted;
+
+			for (auto&& element : from)
+				sorted.push_back(forwardElement<FromT>(element));
+
+			std::ranges::sort(sorted);
+
+			return insertAll(std::move(sorted), to);
+		}
+
+		const size_t size = to.size();
+		size_t index = 0;
+
+		for (auto&& element : from) {
+			while (index < size && to[index] < element)
+				index++;
+
+			// already in the vector, or a duplicate of the element appended last
+			if ((index < size && !(element < to[index])) || (to.size() > size && !(to.back() < element)))
+				continue;
+
+			to.push_back(forwardElement<FromT>(element));
+		}
+
+		// the appended elements are sorted; merging is only needed if they do not all follow the old ones
+		if (size && to.size() > size && to[size] < to[size - 1])
+			std::inplace_merge(to.begin(), to.begin() + size, to.end());
+
+		return { to.size() - size };
+	}
+
+	/**
+	 * @brief Inserts the elements of a bitset-backed set (of the integers whose bits are set) into another, a word at a time.
+	 * @return The number of elements inserted.
+	 */
+	template <typename FromT, size_t N>
+		requires std::same_as<std::remove_cvref_t<FromT>, std::bitset<N>>
+	InsertResult insertAll(FromT&& from, std::bitset<N>& to) {
+		const size_t added = (from & ~to).count();
+		to |= from;
+
+		return { added };
+	}
+
+	/**
+	 * @brief Inserts the elements of an iterable into any iterable with an `insert` method returning a pair whose second member tells whether the element was inserted (such as `std::unordered_set`).
+	 * @details Room is reserved for the new elements first, where the iterable inserted into can reserve it. The nodes of an rvalue iterable of the same type are moved by its `merge` method, where it has one.
+	 * @return The number of elements inserted.
+	 */
+	template <typename FromT, typename ToT>
+	InsertResult insertAll(FromT&& from, ToT& to) {
+		if constexpr (std::same_as<std::remove_cvref_t<FromT>, ToT> && !std::is_lvalue_reference_v<FromT> && !std::is_const_v<std::remove_reference_t<FromT>> && requires { to.merge(from); }) {
+			const size_t size = to.size();
+			to.merge(from);
+
+			return { to.size() - size };
+		}
+
+		if constexpr (std::ranges::sized_range<const std::remove_cvref_t<FromT>> && requires { to.reserve(to.size()); })
+			to.reserve(to.size() + (size_t)std::ranges::size(from));
+
+		size_t added = 0;
+
+		for (auto&& element : from)
+			added += to.insert(forwardElement<FromT>(element)).second;
+
+		return { added };
+	}
+
+	/**
+	 * @brief Erases an element that `insertAll` has just inserted (see `insertAndAssert` with an element to filter for).
+	 * @return `true` if the element was in `to`.
+	 */
+	template <typename ToT, typename ElementT>
+	bool eraseElement(ToT& to, const ElementT& element) {
+		if constexpr (requires { to.reset(element); }) {
+			// a bitset holds no element beyond its size
+			if (!std::in_range<size_t>(element) || (size_t)element >= to.size())
+				return false;
+
+			const bool found = to.test((size_t)element);
+			to.reset((size_t)element);
+
+			return found;
+		}
+		else if constexpr (requires { to.erase(element); })
+			return to.erase(element) != 0;
+		else {
+			// a sorted vector
+			const auto it = std::ranges::lower_bound(to, element);
+
+			if (it == to.end() || element < *it)
+				return false;
+
+			to.erase(it);
+			return true;
+		}
+	}
+
+}
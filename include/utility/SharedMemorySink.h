@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "LockFreeQueue.h"
+#include "LogSink.h"
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief A record read from a `SharedLogRing`.
+	 */
+	struct SharedLogEntry {
+		LogRecord record{};
+		int64_t timestamp = 0;	///< The time the record was written, in nanoseconds since the epoch of `std::chrono::system_clock`.
+	};
+
+	/**
+	 * @brief A single-producer, single-consumer ring of log records in POSIX shared memory (`shm_open` + `mmap`).
+	 * @details The segment holds a header followed by the data bytes. Records are stored as 8-byte aligned frames; a frame that would not fit before the end of the data is preceded by a padding frame covering the rest of it. The producer publishes frames by advancing the write position, and the consumer releases them by advancing the read position, both kept in the segment. Thus records outlive the processes: a producer that restarts appends after what is still unread, and a consumer that restarts resumes where the last one stopped. A producer never waits for the consumer; when the ring is full, records are dropped and counted.
+	 * @note Not supported on Windows: opening a ring throws `LogSinkError`.
+	 */
+	class SharedLogRing {
+	public:
+
+		static constexpr uint64_t MAGIC = 0x474E5253474F4C55;	///< "ULOGSRNG".
+		static constexpr uint32_t VERSION = 1;
+		static constexpr size_t MIN_CAPACITY = 1 << 12;
+
+		/**
+		 * @brief The header of the shared segment.
+		 */
+		struct Header {
+			std::atomic<uint64_t> magic;	///< Written last when the segment is initialized.
+			uint32_t version;
+			uint32_t reserved;
+			uint64_t capacity;				///< The number of data bytes; a power of two.
+			alignas(utility::CACHE_LINE_SIZE) std::atomic<uint64_t> writePosition;
+			alignas(utility::CACHE_LINE_SIZE) std::atomic<uint64_t> readPosition;
+			alignas(utility::CACHE_LINE_SIZE) std::atomic<uint64_t> dropped;
+		};
+
+		static_assert(std::atomic<uint64_t>::is_always_lock_free, "The positions must be lock-free to be shared between processes.");
+
+	private:
+
+		std::string m_Name;
+		Header* m_Header = nullptr;
+		std::byte* m_Data = nullptr;
+		size_t m_MappedSize = 0;
+		uint64_t m_Consumed = 0;	// the read position up to which the consumer has read, but not yet committed
+
+		SharedLogRing(const std::string&, size_t, bool);
+
+	public:
+
+		static SharedLogRing create(const std::string&, size_t);
+		static SharedLogRing open(const std::string&);
+		static bool remove(const std::string&);
+
+		SharedLogRing(SharedLogRing&&) noexcept;
+		SharedLogRing& operator=(SharedLogRing&&) noexcept;
+		~SharedLogRing();
+
+		bool tryWrite(const LogRecord&, int64_t);
+		size_t read(std::vector<SharedLogEntry>&, size_t = SIZE_MAX);
+		void commit();
+
+		/**
+		 * @return The name of the shared memory object.
+		 */
+		const std::string& getName() const {
+			return m_Name;
+		}
+
+		/**
+		 * @return The number of data bytes of the ring.
+		 */
+		size_t capacity() const {
+			return m_Header->capacity;
+		}
+
+		/**
+		 * @return The number of records dropped by producers because the ring was full, since it was created.
+		 */
+		uint64_t droppedCount() const {
+			return m_Header->dropped.load(std::memory_order_relaxed);
+		}
+
+	};
+
+	/**
+	 * @brief The configuration of a `SharedMemorySink`.
+	 */
+	struct SharedMemorySinkOptions {
+		std::string name{};				///< The name of the shared memory object (a leading `/` is added if missing).
+		size_t capacity = 1 << 22;		///< The number of data bytes, rounded up to a power of two; ignored if the ring already exists.
+	};
+
+	/**
+	 * @brief Writes records into a `SharedLogRing`, to be written out by another process (see the `utility-logcollector` tool).
+	 * @details Writing a record is a copy into shared memory, so the logging process does no I/O and never waits for the collector. Records that do not fit are dropped (see `SharedLogRing::droppedCount`).
+	 */
+	class SharedMemorySink : public LogSink {
+		std::mutex m_Mutex;
+		SharedLogRing m_Ring;
+
+	public:
+
+		explicit SharedMemorySink(const SharedMemorySinkOptions&);
+
+		void write(std::span<const LogRecord>) override;
+
+		/**
+		 * @return The number of records dropped because the ring was full.
+		 */
+		uint64_t droppedCount() const {
+			return m_Ring.droppedCount();
+		}
+
+	};
+
+}
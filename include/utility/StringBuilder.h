@@ -0,0 +1,102 @@
+#pragma once
+
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "fmt/format.h"
+
+// DECLARATION OF utility NAMESPACE (AS INLINE)
+namespace m0st4fa {
+	inline namespace utility {}
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Builds a string in place: every append, including formatted ones, writes straight into the result.
+	 * @details Given an estimate of the final size that is an upper bound, the result is allocated exactly once (and not at all if it fits in the small-string buffer of `std::string`). Formatted appends use `fmt::format_to` on a back inserter of the result, which `fmt` writes to directly instead of going through a temporary string.
+	 * @tparam String The type of the result: `std::string`, or a `std::basic_string<char>` with another allocator, such as `std::pmr::string`.
+	 */
+	template <typename String = std::string>
+	class BasicStringBuilder {
+		String m_String;
+
+	public:
+
+		using allocator_type = typename String::allocator_type;
+
+		BasicStringBuilder() = default;
+
+		/**
+		 * @param[in] capacity The estimated size of the result.
+		 * @param[in] allocator The allocator of the result (for `std::pmr::string`, a `std::pmr::memory_resource*` converts to it).
+		 */
+		explicit BasicStringBuilder(size_t capacity, const allocator_type& allocator = allocator_type{})
+			: m_String(allocator)
+		{
+			m_String.reserve(capacity);
+		}
+
+		/**
+		 * @brief Makes room for at least `capacity` characters in total.
+		 */
+		void reserve(size_t capacity) {
+			m_String.reserve(capacity);
+		}
+
+		BasicStringBuilder& append(std::string_view text) {
+			m_String.append(text);
+			return *this;
+		}
+
+		BasicStringBuilder& append(char c) {
+			m_String.push_back(c);
+			return *this;
+		}
+
+		BasicStringBuilder& append(size_t count, char c) {
+			m_String.append(count, c);
+			return *this;
+		}
+
+		/**
+		 * @brief Appends the result of formatting `args` according to `formatStr`.
+		 */
+		template <typename... Args>
+		BasicStringBuilder& format(fmt::format_string<Args...> formatStr, Args&&... args) {
+			fmt::format_to(std::back_inserter(m_String), formatStr, std::forward<Args>(args)...);
+			return *this;
+		}
+
+		size_t size() const {
+			return m_String.size();
+		}
+
+		size_t capacity() const {
+			return m_String.capacity();
+		}
+
+		std::string_view view() const {
+			return m_String;
+		}
+
+		/**
+		 * @return The built string, leaving the builder empty.
+		 */
+		String release() {
+			return std::move(m_String);
+		}
+
+	};
+
+	using StringBuilder = BasicStringBuilder<>;
+
+	/**
+	 * @brief A `BasicStringBuilder` of a `std::pmr::string`, which allocates from a `std::pmr::memory_resource` (e.g. a request-scoped `std::pmr::monotonic_buffer_resource`).
+	 */
+	using PmrStringBuilder = BasicStringBuilder<std::pmr::string>;
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StringBuilder.h"
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief The output formats of `renderTable`.
+	 */
+	enum class TABLE_STYLE {
+		TS_BOX,			///< Boxed cells with a rule between rows, in the style of `tabulate`: `+---+` rules and `| x |` cells.
+		TS_PLAIN,		///< Left-aligned columns separated by two spaces; the last column is not padded.
+		TS_CSV,			///< Comma-separated values (RFC 4180 quoting).
+		TS_TSV,			///< Tab-separated values (tabs, newlines and backslashes are escaped with backslashes).
+		TS_MARKDOWN,	///< A GitHub-flavored Markdown table; the first row is the header.
+		TS_COUNT,
+	};
+
+	size_t getEscapedSize(std::string_view, TABLE_STYLE);
+	void appendEscaped(StringBuilder&, std::string_view, TABLE_STYLE);
+	void appendEscaped(PmrStringBuilder&, std::string_view, TABLE_STYLE);
+
+	/**
+	 * @brief Renders a table in two passes: the first one measures the cells (and thus the widths of the columns and the size of the output), and the second one writes them into a string allocated once.
+	 * @tparam String The type of the result: `std::string` or `std::pmr::string`.
+	 * @tparam GetCell A callable taking a row and a column index and returning the text of the cell as a `std::string_view`, which only has to stay valid until the next call.
+	 * @param[in] rowCount The number of rows, including the header row (if any).
+	 * @param[in] columnCount The number of columns.
+	 * @param[in] getCell Returns the text of a cell. It is called twice per cell.
+	 * @param[in] style The output format.
+	 * @param[in] allocator The allocator of the result and of the column widths (for `std::pmr::string`, a `std::pmr::memory_resource*` converts to it).
+	 * @return The rendered table.
+	 */
+	template <typename String = std::string, typename GetCell>
+		requires std::convertible_to<std::invoke_result_t<GetCell&, size_t, size_t>, std::string_view>
+	String renderTable(size_t rowCount, size_t columnCount, GetCell getCell, TABLE_STYLE style = TABLE_STYLE::TS_BOX, const typename String::allocator_type& allocator = {}) {
+		using SizeAllocator = typename std::allocator_traits<typename String::allocator_type>::template rebind_alloc<size_t>;
+
+		if (!rowCount || !columnCount)
+			return String(allocator);
+
+		// FIRST PASS: the widths of the columns and the size of the output
+		std::vector<size_t, SizeAllocator> widths(columnCount, style == TABLE_STYLE::TS_MARKDOWN ? 3 : 0, SizeAllocator(allocator));
+		size_t cellsSize = 0;
+		size_t lastCellsSize = 0;
+
+		for (size_t row = 0; row < rowCount; row++)
+			for (size_t column = 0; column < columnCount; column++) {
+				const size_t size = getEscapedSize(getCell(row, column), style);
+
+				widths[column] = std::max(widths[column], size);
+				cellsSize += size;
+
+				if (column == columnCount - 1)
+					lastCellsSize += size;
+			}
+
+		size_t lineSize = 1;
+
+		for (const size_t width : widths)
+			lineSize += width + 3;
+
+		size_t size = 0;
+
+		switch (style) {
+			case TABLE_STYLE::TS_BOX:
+				size = (2 * rowCount + 1) * lineSize + 2 * rowCount;
+				break;
+			case TABLE_STYLE::TS_MARKDOWN:
+				size = (rowCount + 1) * (lineSize + 1);
+				break;
+			case TABLE_STYLE::TS_PLAIN:
+				size = rowCount * (lineSize - widths.back() - 3 - columnCount + 1) + lastCellsSize;
+				break;
+			default:
+				size = cellsSize + rowCount * columnCount;
+		}
+
+		// SECOND PASS: writing
+		BasicStringBuilder<String> builder{ size, allocator };
+
+		auto appendRule = [&](char corner, char fill) {
+			builder.append(corner);
+
+			for (const size_t width : widths) {
+				builder.append(width + 2, fill);
+				builder.append(corner);
+			}
+			};
+
+		if (style == TABLE_STYLE::TS_BOX)
+			appendRule('+', '-');
+
+		for (size_t row = 0; row < rowCount; row++) {
+			if (style == TABLE_STYLE::TS_BOX)
+				builder.append('\n');
+
+			for (size_t column = 0; column < columnCount; column++) {
+				const std::string_view cell = getCell(row, column);
+				const bool last = column == columnCount - 1;
+
+				switch (style) {
+					case TABLE_STYLE::TS_BOX:
+					case TABLE_STYLE::TS_MARKDOWN:
+						builder.append(column ? " " : "| ");
+						appendEscaped(builder, cell, style);
+						builder.append(widths[column] - getEscapedSize(cell, style), ' ');
+						builder.append(" |");
+						break;
+					case TABLE_STYLE::TS_PLAIN:
+						builder.append(cell);
+
+						if (!last)
+							builder.append(widths[column] - cell.size() + 2, ' ');
+
+						break;
+					default:
+						appendEscaped(builder, cell, style);
+
+						if (!last)
+							builder.append(style == TABLE_STYLE::TS_CSV ? ',' : '\t');
+				}
+			}
+
+			if (style == TABLE_STYLE::TS_BOX) {
+				builder.append('\n');
+				appendRule('+', '-');
+			}
+			else
+				builder.append('\n');
+
+			// the header rule of Markdown
+			if (style == TABLE_STYLE::TS_MARKDOWN && row == 0) {
+				appendRule('|', '-');
+				builder.append('\n');
+			}
+		}
+
+		return builder.release();
+	}
+
+	std::string renderTable(const std::vector<std::vector<std::string>>&, TABLE_STYLE = TABLE_STYLE::TS_BOX);
+
+}
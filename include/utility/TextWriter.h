@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "fmt/format.h"
+#include "StringBuilder.h"
+
+// EXCEPTIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief An exception to be thrown by a writer that could not write to its destination.
+	 */
+	struct WriteError : std::exception {
+
+		std::string msg{};
+
+		const char* what() const noexcept(true) override {
+			return "Write error.";
+		}
+
+		WriteError(const std::string& msg)
+			: msg(msg)
+		{
+		}
+	};
+
+}
+
+// CONCEPTS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Checks whether `W` can be written text to, by appending strings and characters.
+	 * @details Writers also provide a variadic `format` member, appending the result of `fmt::format`, which a concept cannot check.
+	 * @tparam W The type of the writer.
+	 */
+	template <typename W>
+	concept TextWriter = requires (W writer, std::string_view text, char c) {
+		writer.append(text);
+		writer.append(c);
+	};
+
+}
+
+// DECLARATIONS
+namespace m0st4fa::utility {
+
+	/**
+	 * @brief Writes text to an output iterator.
+	 * @tparam Out The type of the output iterator.
+	 */
+	template <std::output_iterator<const char&> Out>
+	class IteratorWriter {
+		Out m_Out;
+
+	public:
+
+		explicit IteratorWriter(Out out)
+			: m_Out(std::move(out))
+		{
+		}
+
+		IteratorWriter& append(std::string_view text) {
+			m_Out = std::copy(text.begin(), text.end(), std::move(m_Out));
+			return *this;
+		}
+
+		IteratorWriter& append(char c) {
+			*m_Out = c;
+			++m_Out;
+			return *this;
+		}
+
+		template <typename... Args>
+		IteratorWriter& format(fmt::format_string<Args...> formatStr, Args&&... args) {
+			m_Out = fmt::format_to(std::move(m_Out), formatStr, std::forward<Args>(args)...);
+			return *this;
+		}
+
+		/**
+		 * @return The iterator past the last character written.
+		 */
+		Out getIterator() const {
+			return m_Out;
+		}
+
+	};
+
+	/**
+	 * @brief Writes text to a `std::ostream`, which does its own buffering.
+	 */
+	class OstreamWriter {
+		std::ostream& m_Stream;
+
+	public:
+
+		explicit OstreamWriter(std::ostream& stream)
+			: m_Stream(stream)
+		{
+		}
+
+		OstreamWriter& append(std::string_view text) {
+			m_Stream.write(text.data(), (std::streamsize)text.size());
+			return *this;
+		}
+
+		OstreamWriter& append(char c) {
+			m_Stream.put(c);
+			return *this;
+		}
+
+		template <typename... Args>
+		OstreamWriter& format(fmt::format_string<Args...> formatStr, Args&&... args) {
+			fmt::format_to(std::ostreambuf_iterator<char>{ m_Stream }, formatStr, std::forward<Args>(args)...);
+			return *this;
+		}
+
+	};
+
+	/**
+	 * @brief Writes text to a file descriptor through a fixed-size buffer, so that text is written in bounded chunks whatever its total size.
+	 * @details The buffer is written out when it fills up, on `flush` and on destruction. Text larger than the buffer is written directly.
+	 */
+	class FdWriter {
+		int m_Fd;
+		std::unique_ptr<char[]> m_Buffer;
+		size_t m_Capacity;
+		size_t m_Size = 0;
+
+		void writeOut(const char*, size_t);
+
+	public:
+
+		static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 16;
+
+		explicit FdWriter(int, size_t = DEFAULT_BUFFER_SIZE);
+		FdWriter(const FdWriter&) = delete;
+		FdWriter& operator=(const FdWriter&) = delete;
+		~FdWriter();
+
+		FdWriter& append(std::string_view);
+
+		FdWriter& append(char c) {
+			if (m_Size == m_Capacity)
+				flush();
+
+			m_Buffer[m_Size++] = c;
+			return *this;
+		}
+
+		/**
+		 * @brief Appends the result of formatting `args` according to `formatStr`, through a stack buffer.
+		 */
+		template <typename... Args>
+		FdWriter& format(fmt::format_string<Args...> formatStr, Args&&... args) {
+			fmt::memory_buffer buffer;
+			fmt::format_to(std::back_inserter(buffer), formatStr, std::forward<Args>(args)...);
+
+			return append(std::string_view{ buffer.data(), buffer.size() });
+		}
+
+		void flush();
+
+	};
+
+}
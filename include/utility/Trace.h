@@ -0,0 +1,186 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define UTILITY_TRACE_CLOCK_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UTILITY_TRACE_CLOCK_TSC
+#endif
+
+#define UTILITY_TRACE_CONCAT_IMPL(a, b) a##b
+#define UTILITY_TRACE_CONCAT(a, b) UTILITY_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Records a trace span covering the rest of the enclosing scope.
+ * @details Expands to nothing unless `UTILITY_ENABLE_TRACING` is defined.
+ * @param name The name of the span: a string literal, or any string (which is then copied once per span).
+ */
+#ifdef UTILITY_ENABLE_TRACING
+#define UTILITY_TRACE_SCOPE(name) ::m0st4fa::TraceSpan UTILITY_TRACE_CONCAT(utilityTraceSpan, __LINE__){ name }
+#else
+#define UTILITY_TRACE_SCOPE(name) ((void)0)
+#endif
+
+/**
+ * @brief Records a trace span named after the enclosing function, covering the rest of its body.
+ * @details Expands to nothing unless `UTILITY_ENABLE_TRACING` is defined.
+ */
+#define UTILITY_TRACE_FUNCTION() UTILITY_TRACE_SCOPE(std::source_location::current().function_name())
+
+// DECLARATIONS
+namespace m0st4fa {
+
+	/**
+	 * @brief A cheap monotonic clock: the time-stamp counter on x86, `std::chrono::steady_clock` elsewhere.
+	 * @details Ticks are converted to time by calibrating against `std::chrono::steady_clock`.
+	 */
+	struct TraceClock {
+
+		/**
+		 * @return The current tick count.
+		 */
+		static uint64_t now() {
+#ifdef UTILITY_TRACE_CLOCK_TSC
+			return __rdtsc();
+#else
+			return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		static double getTicksPerNanosecond();
+
+	};
+
+	/**
+	 * @brief A number of `TraceClock` ticks, converted to time only when it is read.
+	 */
+	struct TraceTicks {
+		uint64_t count = 0;
+
+		/**
+		 * @return The ticks as a duration (see `TraceClock::getTicksPerNanosecond`, which may wait for the calibration interval).
+		 */
+		std::chrono::nanoseconds toNanoseconds() const {
+			return std::chrono::nanoseconds{ (int64_t)((double)count / TraceClock::getTicksPerNanosecond()) };
+		}
+	};
+
+	/**
+	 * @brief A completed trace span.
+	 */
+	struct TraceEvent {
+		const char* name;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+	/**
+	 * @brief Collects trace spans in per-thread buffers and exports them in the Chrome trace event format (viewable in Perfetto or about://tracing).
+	 * @details Spans are appended to fixed-size chunks owned by their thread, so recording one neither locks nor allocates (except for a new chunk every few thousand spans).
+	 */
+	class Tracer {
+		static inline std::atomic<bool> s_Enabled{ true };
+
+	public:
+
+		/**
+		 * @brief Enables or disables the recording of spans at runtime.
+		 */
+		static void setEnabled(bool enabled) {
+			s_Enabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @return `true` if spans are being recorded; `false` otherwise.
+		 */
+		static bool isEnabled() {
+			return s_Enabled.load(std::memory_order_relaxed);
+		}
+
+		static void record(const char*, uint64_t, uint64_t);
+		static const char* intern(std::string_view);
+
+		static size_t exportChromeTrace(std::ostream&);
+		static bool exportChromeTrace(const std::string&);
+		static void clear();
+
+	};
+
+	/**
+	 * @brief Records a trace span from its construction to its destruction.
+	 * @note Spans nest naturally: a span created while another one is alive is shown inside it.
+	 */
+	class TraceSpan {
+		const char* m_Name;
+		uint64_t m_Begin;
+
+	public:
+
+		/**
+		 * @param[in] name The name of the span. It must outlive the program's tracing (e.g., a string literal).
+		 */
+		explicit TraceSpan(const char* name)
+			: m_Name(Tracer::isEnabled() ? name : nullptr), m_Begin(m_Name ? TraceClock::now() : 0)
+		{
+		}
+
+		/**
+		 * @param[in] name The name of the span. It is copied.
+		 */
+		explicit TraceSpan(std::string_view name)
+			: m_Name(Tracer::isEnabled() ? Tracer::intern(name) : nullptr), m_Begin(m_Name ? TraceClock::now() : 0)
+		{
+		}
+
+		explicit TraceSpan(const std::string& name)
+			: TraceSpan(std::string_view{ name })
+		{
+		}
+
+		TraceSpan(const TraceSpan&) = delete;
+		TraceSpan& operator=(const TraceSpan&) = delete;
+
+		~TraceSpan() {
+			if (m_Name)
+				Tracer::record(m_Name, m_Begin, TraceClock::now());
+		}
+
+	};
+
+	/**
+	 * @brief Measures the time from its construction to its destruction, adding it to a count of ticks.
+	 * @details Only the raw ticks are added, so that the destructor costs a clock read; they are converted to time when read (see `TraceTicks::toNanoseconds`).
+	 */
+	class ScopedTimer {
+		TraceTicks& m_Elapsed;
+		uint64_t m_Begin;
+
+	public:
+
+		/**
+		 * @param[out] elapsed The ticks the measured time is added to.
+		 */
+		explicit ScopedTimer(TraceTicks& elapsed)
+			: m_Elapsed(elapsed), m_Begin(TraceClock::now())
+		{
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		~ScopedTimer() {
+			m_Elapsed.count += TraceClock::now() - m_Begin;
+		}
+
+	};
+
+}
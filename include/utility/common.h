@@ -7,10 +7,26 @@
 #include <type_traits>
 #include <concepts>
 #include <source_location>
+#include <cmath>
+#include <string_view>
+#include <ostream>
+#include <ranges>
+#include <memory_resource>
+#include <utility>
 
 #include "fmt/ranges.h"
 #include "tabulate/table.hpp"
 #include "ANSI.h"
+#include "TextWriter.h"
+#include "NumberFormat.h"
+#include "NumberParse.h"
+#include "IntegerMath.h"
+#include "TableFormat.h"
+#include "ColumnOccupancy.h"
+#include "IterableEquality.h"
+#include "Membership.h"
+#include "SetUnion.h"
+#include "FlatSet.h"
 
 // DECLARATION OF utility NAMESPACE (AS INLINE)
 namespace m0st4fa {
@@ -75,6 +91,32 @@ namespace m0st4fa::utility {
 		iterable.contains(iterable.at(0)); 
 	};
 
+	template <typename T>
+	inline constexpr bool IS_MAP = false;
+
+	template <typename K, typename V, typename C, typename A>
+	inline constexpr bool IS_MAP<std::map<K, V, C, A>> = true;
+
+	/**
+	 * @brief Checks whether `T` is a `std::map`.
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept IsMap = IS_MAP<T>;
+
+	template <typename T>
+	inline constexpr bool IS_2D_ARRAY = false;
+
+	template <NumConvertableToString T, size_t xdim, size_t ydim>
+	inline constexpr bool IS_2D_ARRAY<std::array<std::array<T, ydim>, xdim>> = true;
+
+	/**
+	 * @brief Checks whether `T` is a 2D `std::array` of numbers convertible to string (see `NumConvertableToString`).
+	 * @tparam T The type to be checked.
+	 */
+	template <typename T>
+	concept Is2DArray = IS_2D_ARRAY<T>;
+
 	///**
 	// * @brief Checks whether an object type `T` supports comparison with less than operator (<).
 	// * @tparam T The type of the object to be checked.
@@ -89,9 +131,148 @@ namespace m0st4fa::utility {
 // STRING
 namespace m0st4fa::utility {
 
+	/**
+	 * @brief Estimates the length of the string `toString` makes of an element of an iterable.
+	 * @details The estimate is exact for integers and strings and an upper bound for floating-point numbers. The length of other elements, which are converted by `stringfy` or `operator std::string`, is guessed.
+	 * @tparam ElementType The element type of the iterable, which decides the conversion.
+	 * @param[in] element The element.
+	 * @return The estimated length.
+	 */
+	template <typename ElementType, typename T>
+	size_t estimateStringSize(const T& element) {
+		if constexpr (NumConvertableToString<ElementType>) {
+			const auto value = +element;
+
+			if constexpr (std::floating_point<decltype(value)>) {
+				// "-" + the integral digits (plus one for rounding up) + "." + 6 decimals
+				const long double magnitude = std::fabs((long double)value);
+
+				if (!std::isfinite(magnitude))
+					return 4;
+
+				return 1 + (magnitude >= 1 ? (size_t)std::log10(magnitude) + 2 : 1) + 7;
+			}
+			else
+				return countDigits(value);
+		}
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			return std::string_view{ element }.size();
+		else
+			return 16;
+	}
+
+	/**
+	 * @brief Appends the string `toString` makes of an element of an iterable: `std::to_string` for numbers, `stringfy` for `Stringfyble` elements and `operator std::string` otherwise.
+	 * @tparam ElementType The element type of the iterable, which decides the conversion.
+	 * @param[out] writer The writer to append to.
+	 * @param[in] element The element.
+	 */
+	template <typename ElementType, TextWriter W, typename T>
+	void appendString(W& writer, const T& element) {
+		if constexpr (NumConvertableToString<ElementType>) {
+			// `+` promotes like `std::to_string` does (e.g., a `char` is written as a number)
+			const auto value = +element;
+
+			if constexpr (std::floating_point<decltype(value)>)
+				appendFixed(writer, value);
+			else
+				appendNumber(writer, value);
+		}
+		else if constexpr (Stringfyble<ElementType>)
+			writer.append(stringfy(element));
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			writer.append(std::string_view{ element });
+		else
+			writer.append((std::string)element);
+	}
+
+	/**
+	 * @brief Estimates the length of a value formatted by `fmt` with the "{}" format specification.
+	 * @details The estimate is exact for integers and strings and an upper bound for other arithmetic types; the length of other values is guessed.
+	 * @param[in] value The value.
+	 * @return The estimated length.
+	 */
+	template <typename T>
+	size_t estimateFormattedSize(const T& value) {
+		if constexpr (std::same_as<T, bool>)
+			return 5;
+		else if constexpr (std::same_as<T, char> || std::same_as<T, wchar_t>)
+			return 1;
+		else if constexpr (std::integral<T>)
+			return countDigits(value);
+		else if constexpr (std::floating_point<T>)
+			return 24;	// the longest shortest round-trip representation of a `double`, e.g., "-2.2250738585072014e-308"
+		else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			return std::string_view{ value }.size();
+		else
+			return 16;
+	}
+
+	/**
+	 * @brief Appends a value as `fmt` formats it with the "{}" format specification, writing integers with `appendNumber`.
+	 * @param[out] writer The writer to append to.
+	 * @param[in] value The value.
+	 */
+	template <TextWriter W, typename T>
+	void appendFormatted(W& writer, const T& value) {
+		// `fmt` writes characters as characters and booleans as words
+		if constexpr (AppendableNumber<T> && std::integral<T> && !std::same_as<T, char> && !std::same_as<T, wchar_t>)
+			appendNumber(writer, value);
+		else
+			writer.format("{}", value);
+	}
+
+	/**
+	 * @brief Estimates the length of the string representation of a general iterable (see `toString`).
+	 */
+	template <typename T>
+	size_t estimateToStringSize(const T& iterable, bool asList = true) {
+		using ElementType = decltype(T{}.at(0));
+
+		const size_t separatorSize = asList ? 2 : 1;
+		size_t size = 4;
+
+		for (const auto& element : iterable)
+			size += estimateStringSize<ElementType>(element) + separatorSize;
+
+		return size;
+	}
+
+	/**
+	 * @brief Appends the string representation of a general iterable (see `toString`).
+	 * @details Any input range is accepted, including views and generators, which are traversed once.
+	 */
+	template <TextWriter W, std::ranges::input_range R>
+		requires (!IsMap<std::remove_cvref_t<R>> && !Is2DArray<std::remove_cvref_t<R>>)
+	void appendToString(W& writer, R&& range, bool asList = true) {
+		using ElementType = std::ranges::range_reference_t<R>;
+
+		const std::string_view separator = asList ? ", " : "\n";
+
+		auto it = std::ranges::begin(range);
+		const auto end = std::ranges::end(range);
+
+		writer.append("{ ");
+
+		if (it == end) {
+			writer.append(" }");
+			return;
+		}
+
+		appendString<ElementType>(writer, *it);
+
+		for (++it; it != end; ++it) {
+			writer.append(separator);
+			appendString<ElementType>(writer, *it);
+		}
+
+		writer.append(" }");
+	}
+
 	/**
 	 * @brief Converts general iterables to strings.
 	 * @attention The elements of the iterable must be convertible to strings.
+	 * @details The size of the result is estimated first, so that it is allocated once (see `estimateStringSize` for when the estimate may fall short).
 	 * @tparam T The type of the iterable.
 	 * @param[in] iterable The iterable to be converted to a string.
 	 * @param[in] asList Whether or not to format the iterable graphically as a list. If set to false, each element appears on a new line.
@@ -99,59 +280,60 @@ namespace m0st4fa::utility {
 	 */
 	template <typename T>
 	std::string toString(const T& iterable, bool asList = true) {
-		using ElementType = decltype(T{}.at(0));
+		StringBuilder builder{ estimateToStringSize(iterable, asList) };
 
-		std::string separator = asList ? ", " : "\n";
+		appendToString(builder, iterable, asList);
 
-		std::string temp = "{ ";
-
-		if (iterable.empty())
-			return temp += " }";
-
-		if constexpr (NumConvertableToString<ElementType>)
-			temp += std::to_string(*iterable.begin());
-		else if (Stringfyble<ElementType>)
-			temp += stringfy(*iterable.begin());
-		else
-			temp += (std::string)*iterable.begin();
+		return builder.release();
+	}
 
-		for (size_t i = 0; const auto & element : iterable) {
-			// skip the first element
-			if (!i) {
-				i++;
-				continue;
-			}
+	/**
+	 * @brief Converts general iterables to strings allocated from a memory resource (see `toString`).
+	 * @details The result, the only buffer the conversion needs, is allocated from `resource`, so that, with a `std::pmr::monotonic_buffer_resource`, the strings of a request can be released in bulk.
+	 * @tparam T The type of the iterable.
+	 * @param[in] iterable The iterable to be converted to a string.
+	 * @param[in] resource The memory resource to allocate the result from.
+	 * @param[in] asList Whether or not to format the iterable graphically as a list. If set to false, each element appears on a new line.
+	 * @return The string representation of the iterable.
+	 */
+	template <typename T>
+	std::pmr::string toString(const T& iterable, std::pmr::memory_resource* resource, bool asList = true) {
+		PmrStringBuilder builder{ estimateToStringSize(iterable, asList), resource };
 
-			if constexpr (NumConvertableToString<ElementType>)
-				temp += separator + std::to_string(element);
-			else if (Stringfyble<ElementType>)
-				temp += separator + stringfy(element);
-			else
-				temp += separator + (std::string)element;
-		}
+		appendToString(builder, iterable, asList);
 
-		return temp += " }";
+		return builder.release();
 	}
 
 	/**
-	 * @brief Converts a 2D array to a string.
-	 * @attention The elements of the array must be convertible to strings.
-	 * @tparam T The type of objects of the 2D array.
-	 * @tparam xdim The size of the first dimension (x dimension).
-	 * @tparam ydim The size of the second dimension (y dimension).
-	 * @param[in] array The 2D array to be converted.
-	 * @param[in] asList Whether or not to format the array graphically as a list. If set to false, each element appears on a new line.
-	 * @returns The string representation of `array`.
-	 * 
+	 * @brief Estimates the length of the string representation of a 2D array (see `toString`).
+	 * @note `asList` is accepted for uniformity with the other overloads and ignored: every non-zero element is on its own line.
 	 */
 	template <NumConvertableToString T, size_t xdim, size_t ydim>
-	std::string toString(const std::array<std::array<T, ydim>, xdim>& array, bool asList = true) {
-			std::string separator = asList ? ", " : "\n";
+	size_t estimateToStringSize(const std::array<std::array<T, ydim>, xdim>& array, [[maybe_unused]] bool asList = true) {
+		size_t size = 4;
+
+		for (size_t x = 0; x < xdim; x++)
+			for (size_t y = 0; y < ydim; y++)
+				if (array[x][y])
+					// "[x][y] = value\n"
+					size += countDigits(x) + countDigits(y) + estimateFormattedSize(array[x][y]) + 9;
 
-			std::string temp = "{ ";
+		return size;
+	}
+
+	/**
+	 * @brief Appends the string representation of a 2D array (see `toString`).
+	 * @note `asList` is accepted for uniformity with the other overloads and ignored: every non-zero element is on its own line.
+	 */
+	template <TextWriter W, NumConvertableToString T, size_t xdim, size_t ydim>
+	void appendToString(W& writer, const std::array<std::array<T, ydim>, xdim>& array, [[maybe_unused]] bool asList = true) {
+			writer.append("{ ");
 
-			if (array.empty())
-				return temp += " }";
+			if (array.empty()) {
+				writer.append(" }");
+				return;
+			}
 
 			// if the array is not empty
 
@@ -168,14 +350,86 @@ namespace m0st4fa::utility {
 						continue;
 					}
 
-					temp += fmt::format("[{}][{}] = {}\n", x, y, subarr.at(y));
+					writer.append('[');
+					appendNumber(writer, x);
+					writer.append("][");
+					appendNumber(writer, y);
+					writer.append("] = ");
+					appendFormatted(writer, subarr.at(y));
+					writer.append('\n');
 					y++;
 				}
 
 				x++;
 			}
 
-			return temp += " }";
+			writer.append(" }");
+		}
+
+	/**
+	 * @brief Converts a 2D array to a string.
+	 * @attention The elements of the array must be convertible to strings.
+	 * @tparam T The type of objects of the 2D array.
+	 * @tparam xdim The size of the first dimension (x dimension).
+	 * @tparam ydim The size of the second dimension (y dimension).
+	 * @param[in] array The 2D array to be converted.
+	 * @param[in] asList Whether or not to format the array graphically as a list. If set to false, each element appears on a new line.
+	 * @returns The string representation of `array`.
+	 * 
+	 */
+	template <NumConvertableToString T, size_t xdim, size_t ydim>
+	std::string toString(const std::array<std::array<T, ydim>, xdim>& array, bool asList = true) {
+			StringBuilder builder{ estimateToStringSize(array, asList) };
+
+			appendToString(builder, array, asList);
+
+			return builder.release();
+		}
+
+	/**
+	 * @brief Converts a 2D array to a string allocated from a memory resource (see `toString`).
+	 * @param[in] array The 2D array to be converted.
+	 * @param[in] resource The memory resource to allocate the result from.
+	 * @param[in] asList Whether or not to format the array graphically as a list.
+	 * @returns The string representation of `array`.
+	 */
+	template <NumConvertableToString T, size_t xdim, size_t ydim>
+	std::pmr::string toString(const std::array<std::array<T, ydim>, xdim>& array, std::pmr::memory_resource* resource, bool asList = true) {
+		PmrStringBuilder builder{ estimateToStringSize(array, asList), resource };
+
+		appendToString(builder, array, asList);
+
+		return builder.release();
+	}
+
+	/**
+	 * @brief Estimates the length of the string representation of a map (see `toString`).
+	 */
+	template<typename K, typename V>
+	size_t estimateToStringSize(const std::map<K, V>& map) {
+			size_t size = 0;
+
+			for (const auto& pair : map)
+				// "key : value\n"
+				size += estimateFormattedSize(pair.first) + estimateToStringSize(pair.second) + 4;
+
+			return size;
+		}
+
+	/**
+	 * @brief Appends the string representation of a map (see `toString`).
+	 * @note `asList` is accepted for uniformity with the other overloads and ignored: every pair is on its own line.
+	 */
+	template<TextWriter W, typename K, typename V>
+	void appendToString(W& writer, const std::map<K, V>& map, [[maybe_unused]] bool asList = true) {
+			for (const auto& pair : map) {
+				// FORMAT:
+				// Key : Value
+				appendFormatted(writer, pair.first);
+				writer.append(" : ");
+				appendToString(writer, pair.second);
+				writer.append('\n');
+			}
 		}
 
 	/**
@@ -187,21 +441,160 @@ namespace m0st4fa::utility {
 	 */
 	template<typename K, typename V>
 	std::string toString(const std::map<K, V>& map) {
-			using MapType = std::map<K, V>;
-			std::string res;
+			StringBuilder builder{ estimateToStringSize(map) };
 
-			for (const auto& pair : map)
-				// FORMAT:
-				// Key : Value
-				res += fmt::format("{} : {}\n", pair.first, toString(pair.second));
+			appendToString(builder, map);
 
-			return res;
+			return builder.release();
 		};
 
+	/**
+	 * @brief Converts a map to a string allocated from a memory resource (see `toString`).
+	 * @param[in] map The map to be converted to a string.
+	 * @param[in] resource The memory resource to allocate the result from.
+	 * @return The string representation of `map`.
+	 */
+	template<typename K, typename V>
+	std::pmr::string toString(const std::map<K, V>& map, std::pmr::memory_resource* resource) {
+		PmrStringBuilder builder{ estimateToStringSize(map), resource };
+
+		appendToString(builder, map);
+
+		return builder.release();
+	}
+
+	/**
+	 * @brief Writes the string representation of an iterable, a 2D array or a map (see `toString`) to an output iterator, as it is being formatted.
+	 * @details Unlike `toString`, any input range is accepted, including views and generators, and nothing is materialized.
+	 * @param[out] out The output iterator to write to.
+	 * @param[in] value The value to be written.
+	 * @param[in] asList Whether or not to format the value graphically as a list (see `toString`).
+	 * @return The iterator past the last character written.
+	 */
+	template <std::output_iterator<const char&> Out, typename T>
+	Out formatTo(Out out, T&& value, bool asList = true) {
+		IteratorWriter<Out> writer{ std::move(out) };
+
+		appendToString(writer, std::forward<T>(value), asList);
+
+		return writer.getIterator();
+	}
+
+	/**
+	 * @brief Writes the string representation of an iterable, a 2D array or a map (see `toString`) to a stream, as it is being formatted.
+	 * @details The stream's own buffer bounds the memory used, whatever the size of `value`.
+	 * @param[out] stream The stream to write to.
+	 * @param[in] value The value to be written.
+	 * @param[in] asList Whether or not to format the value graphically as a list (see `toString`).
+	 * @return `stream`.
+	 */
+	template <typename T>
+	std::ostream& formatTo(std::ostream& stream, T&& value, bool asList = true) {
+		OstreamWriter writer{ stream };
+
+		appendToString(writer, std::forward<T>(value), asList);
+
+		return stream;
+	}
+
+	/**
+	 * @brief Writes the string representation of an iterable, a 2D array or a map (see `toString`) to a file descriptor, in chunks of at most the size of the writer's buffer.
+	 * @param[out] writer The writer of the file descriptor. Call `flush` on it to write out the last chunk.
+	 * @param[in] value The value to be written.
+	 * @param[in] asList Whether or not to format the value graphically as a list (see `toString`).
+	 * @return `writer`.
+	 */
+	template <typename T>
+	FdWriter& formatTo(FdWriter& writer, T&& value, bool asList = true) {
+		appendToString(writer, std::forward<T>(value), asList);
+
+		return writer;
+	}
+
 	std::string toString(const std::source_location&, bool = false);
-	
+
+	/**
+	 * @brief The number of rows above which `toString` renders 2D tables with `renderTable` instead of `tabulate`, which styles every cell separately.
+	 */
+	inline constexpr size_t TABULATE_MAX_ROWS = 256;
+
+	/**
+	 * @brief Renders the states of a 2D table with `renderTable`: a header row of `columns` and a row per state, holding the first target of each occupied cell.
+	 * @tparam E The type of objects within the 2D table.
+	 * @tparam IsOccupied A callable taking a row and a column of `table2D` and returning whether the cell has a value.
+	 * @param[in] table2D The 2D table to be formatted as a string.
+	 * @param[in] columns The columns to be rendered, in order.
+	 * @param[in] isOccupied Checks whether a cell has a value.
+	 * @param[in] style The output format.
+	 * @return A string representation of `table2D`.
+	 */
+	template<typename E, typename IsOccupied>
+	std::string renderStateTable(const std::vector<std::vector<E>>& table2D, const std::vector<size_t>& columns, IsOccupied isOccupied, TABLE_STYLE style) {
+		// the text of the last cell, which only has to live until the next one is requested
+		char buffer[MAX_NUMBER_SIZE<size_t>];
+
+		auto getCell = [&](size_t row, size_t column) -> std::string_view {
+			// the header row
+			if (row == 0) {
+				if (column == 0)
+					return "State";
+
+				buffer[0] = char(columns[column - 1]);
+				return { buffer, 1 };
+			}
+
+			if (column == 0)
+				return { buffer, appendNumber(buffer, row - 1) };
+
+			const size_t col = columns[column - 1];
+
+			if (!isOccupied(row - 1, col))
+				return {};
+
+			return { buffer, appendNumber(buffer, (size_t)*table2D[row - 1][col].begin()) };
+			};
+
+		return renderTable(table2D.size() + 1, columns.size() + 1, getCell, style);
+	}
+
+	/**
+	 * @brief Formats a 2D table (represented by vectors) as a string with `renderTable`, in two passes over the table and a single allocation.
+	 * @details The table has the same contents as with `tabulate` (see the overload without `style`): a header row of the non-empty columns and a row per state.
+	 * @tparam E The type of objects within the 2D table.
+	 * @param[in] table2D The 2D table to be formatted as a string.
+	 * @param[in] getNonEmptyColumns A function that should filter columns according to which one is empty and which is not. Empty columns will not exist in the formatted table.
+	 * @param[in] style The output format.
+	 * @return A string representation of `table2D`.
+	 */
+	template<typename E>
+	std::string toString(const std::vector<std::vector<E>>& table2D, std::function<std::set<size_t>(const std::vector<std::vector<E>>&)> getNonEmptyColumns, TABLE_STYLE style) {
+		const std::set<size_t> nonEmptyColumns = getNonEmptyColumns(table2D);
+
+		return renderStateTable(table2D, { nonEmptyColumns.begin(), nonEmptyColumns.end() }, [&table2D](size_t row, size_t col) {
+			return col < table2D[row].size() && isOccupiedCell(table2D[row][col]);
+			}, style);
+	}
+
+	/**
+	 * @brief Formats a 2D table (represented by vectors) as a string with `renderTable`, leaving out the columns that are empty in every row.
+	 * @details The occupied cells and columns are found by a `ColumnOccupancyIndex` of the table, instead of a `getNonEmptyColumns` callback.
+	 * @tparam E The type of objects within the 2D table.
+	 * @param[in] table2D The 2D table to be formatted as a string.
+	 * @param[in] style The output format.
+	 * @return A string representation of `table2D`.
+	 */
+	template<typename E>
+	std::string toString(const std::vector<std::vector<E>>& table2D, TABLE_STYLE style) {
+		const ColumnOccupancyIndex index{ table2D };
+
+		return renderStateTable(table2D, index.getOccupiedColumns(), [&index](size_t row, size_t col) {
+			return index.isOccupied(row, col);
+			}, style);
+	}
+
 	/**
 	 * @brief Formats a 2D table (represented by vectors) as a string.
+	 * @details Tables of more than `TABULATE_MAX_ROWS` rows are rendered in the same box style with `renderTable` (see the overload taking a `TABLE_STYLE`).
 	 * @todo Make this more general. Now it is designed to convert only FSMTable objects.
 	 * @tparam E The type of objects within the 2D table.
 	 * @param[in] table2D The 2D table to be formatted as a string.
@@ -215,6 +608,9 @@ namespace m0st4fa::utility {
 
 		using namespace tabulate;
 
+		if (table2D.size() > TABULATE_MAX_ROWS)
+			return toString(table2D, getNonEmptyColumns, TABLE_STYLE::TS_BOX);
+
 		// TODO: MAKE THIS MORE GENERAL. NOW IT WILL BE ONLY FOR FSMTABLES
 
 		/* ALGORITHM:
@@ -298,6 +694,7 @@ namespace m0st4fa::utility {
 namespace m0st4fa::utility {
 
 	
+	Expected<size_t, ConversionFailure> tryToInteger(std::string_view);
 	size_t toInteger(const std::string&);
 
 	size_t pow(size_t, size_t);
@@ -307,76 +704,121 @@ namespace m0st4fa::utility {
 // ITERABLE
 namespace m0st4fa::utility {
 
+	/**
+	 * @brief Checks for whether a given element is in (is an element of) a given iterable. 
+	 * @details Intended to implement the "containment/is element of" operator in set theory.
+	 * The search is chosen at compile time: ranges tagged as sorted (see `asSorted`) are searched with a binary search; iterables with their own `contains` or `find` method (such as `std::set`) are searched with it; contiguous ranges of numbers are searched a vector register at a time (see `findValue`); and any other iterable is searched linearly.
+	 * @tparam ElementT The type of the element to check for whether it exists in `iterable` or not.
+	 * @tparam IterableT The type of the iterable that will be checked for containment of `element`.
+	 * @param[in] element The element whose existence in `iterable` will be checked.
+	 * @param[in] iterable The iterable that will be checked for containment of `element`.
+	 * @return `true` if `element` is in iterable; `false` otherwise.
+	 */
+	template <typename ElementT, typename IterableT>
+	bool isIn(const ElementT& element, const IterableT& iterable) {
+			if constexpr (IsSortedRange<IterableT>)
+				return std::ranges::binary_search(iterable, element);
+			else if constexpr (ContainsElement<IterableT, ElementT>)
+				return iterable.contains(element);
+			else if constexpr (FindsElement<IterableT, ElementT>)
+				return iterable.find(element) != iterable.end();
+			else {
+				if constexpr (ContiguousArithmeticRange<IterableT>)
+					if (const std::optional<bool> found = findArithmetic(iterable, element))
+						return *found;
+
+				for (const auto& e : iterable)
+					if (e == element)
+						return true;
+
+				return false;
+			}
+		}
+
+	/**
+	 * @brief Checks for whether any of the given elements (the needles) is in a given iterable (the haystack).
+	 * @details Few needles are searched for one at a time (see `isIn`). From `MIN_NEEDLES_FOR_INDEX` needles on, a haystack that has no faster search than a linear one is indexed first (see `MembershipIndex`), so that each needle is looked up in O(1).
+	 * @tparam NeedlesT The type of the iterable of needles.
+	 * @tparam HaystackT The type of the iterable to be searched.
+	 * @param[in] needles The elements to be searched for.
+	 * @param[in] haystack The iterable to be searched.
+	 * @return `true` if at least one of `needles` is in `haystack`; `false` otherwise.
+	 */
+	template <typename NeedlesT, typename HaystackT>
+	bool isInAny(const NeedlesT& needles, const HaystackT& haystack) {
+			using NeedleT = std::ranges::range_value_t<NeedlesT>;
+			using ElementT = std::ranges::range_value_t<HaystackT>;
+
+			constexpr bool indexable = std::ranges::sized_range<NeedlesT> && std::same_as<NeedleT, ElementT> && (std::integral<ElementT> || Hashable<ElementT>) &&
+				!IsSortedRange<HaystackT> && !ContainsElement<HaystackT, NeedleT> && !FindsElement<HaystackT, NeedleT>;
+
+			if constexpr (indexable)
+				if (std::ranges::size(needles) >= MIN_NEEDLES_FOR_INDEX) {
+					const MembershipIndex<ElementT> index{ haystack };
+
+					return std::ranges::any_of(needles, [&index](const NeedleT& needle) { return index.contains(needle); });
+				}
+
+			for (const auto& needle : needles)
+				if (isIn(needle, haystack))
+					return true;
+
+			return false;
+		}
+
 	/**
 	* @brief Inserts elements from an iterable to another, filtering for some element (avoiding its insertion).
-	* @tparam IterableT The type of both iterables (the iterable to insert from and the one to insert to).
-	* @attention `IterableT` must have a method named `insert`.
+	* @details The elements are inserted in bulk (see `insertAll`): sorted elements are merged in linear time into sets and sorted vectors, and the elements of an rvalue iterable are moved.
+	* @tparam FromT The type of the iterable to insert from.
+	* @tparam IterableT The type of the iterable to insert to.
+	* @attention `IterableT` must have a method named `insert`, or be a sorted `std::vector` (see `insertAll`) or a `std::bitset`.
 	* @tparam ExceptT The type of the object to filter by. This object will never be inserted from `from` to `to`.
 	* @note If the type of `except` is nullptr_t, it is ignored and all elements are added.
 	* @param[in] from The iterable whose elements will be inserted to `to`.
 	* @param[out] to The iterable into which `from` elements will be inserted.
-	* @return `true` if at least one element has been inserted from `from` into `to`; `false` otherwise.
+	* @return The number of elements inserted from `from` into `to`, which converts to `true` if at least one element has been inserted and `false` otherwise.
 	*/
-	template <typename IterableT, typename ExceptT>
-	bool insertAndAssert(const IterableT& from, IterableT& to, ExceptT except) {
-			bool added = false;
+	template <typename FromT, typename IterableT, typename ExceptT>
+	InsertResult insertAndAssert(FromT&& from, IterableT& to, ExceptT except) {
+			if constexpr (std::is_null_pointer_v<ExceptT>)
+				return insertAll(std::forward<FromT>(from), to);
+			else {
+				// rather than filtering every element, erase `except` if it was not in `to` before and has been inserted
+				bool present;
 
-			for (auto element : from) {
-				if (element == except)
-					continue;
+				if constexpr (requires { to.test(except); })
+					present = std::in_range<size_t>(except) && (size_t)except < to.size() && to.test((size_t)except);
+				else
+					present = isIn(except, to);
 
-				auto p = to.insert(element);
+				InsertResult result = insertAll(std::forward<FromT>(from), to);
 
-				if (p.second)
-					added = true;
-			}
+				if (!present && result.added && eraseElement(to, except))
+					result.added--;
 
-			return added;
+				return result;
+			}
 		};
 
 	/**
 	* @brief Inserts elements from an iterable to another.
-	* @tparam IterableT The type of both iterables (the iterable to insert from and the one to insert to).
-	* @attention `IterableT` must have a method named `insert`.
+	* @details The elements are inserted in bulk (see `insertAll`): sorted elements are merged in linear time into sets and sorted vectors, and the elements of an rvalue iterable are moved.
+	* @tparam FromT The type of the iterable to insert from.
+	* @tparam IterableT The type of the iterable to insert to.
+	* @attention `IterableT` must have a method named `insert`, or be a sorted `std::vector` (see `insertAll`) or a `std::bitset`.
 	* @param[in] from The iterable whose elements will be inserted to `to`.
 	* @param[out] to The iterable into which `from` elements will be inserted.
-	* @return `true` if at least one element has been inserted from `from` into `to`; `false` otherwise.
+	* @return The number of elements inserted from `from` into `to`, which converts to `true` if at least one element has been inserted and `false` otherwise.
 	*/
-	template <typename IterableT>
-	bool insertAndAssert(const IterableT& from, IterableT& to) {
-			bool added = false;
-
-			for (auto element : from) {
-				auto p = to.insert(element);
-
-				if (p.second)
-					added = true;
-			}
-
-			return added;
+	template <typename FromT, typename IterableT>
+	InsertResult insertAndAssert(FromT&& from, IterableT& to) {
+			return insertAll(std::forward<FromT>(from), to);
 		};
 
-	/**
-	 * @brief Checks for whether a given element is in (is an element of) a given iterable. 
-	 * @details Intended to implement the "containment/is element of" operator in set theory.
-	 * @tparam ElementT The type of the element to check for whether it exists in `iterable` or not.
-	 * @tparam IterableT The type of the iterable that will be checked for containment of `element`.
-	 * @param[in] element The element whose existence in `iterable` will be checked.
-	 * @param[in] iterable The iterable that will be checked for containment of `element`.
-	 * @return `true` if `element` is in iterable; `false` otherwise.
-	 */
-	template <typename ElementT, typename IterableT>
-	bool isIn(const ElementT element, const IterableT& iterable) {
-			for (const ElementT& e : iterable)
-				if (e == element)
-					return true;
-
-			return false;
-		}
-
 	/**
 	* @brief Checks for whether two iterables are "equal" as in set theory.
 	* @details The definition of equality of iterables used by this function is the same as that in set theory (assuming the iterables are sets). Two iterables are equal iff every element in one of them is an element in the other. The order is not important here.
+	* Iterables with a `contains` method are assumed to be sets (to hold unique elements); every element of one is looked up in the other. Other iterables are compared as multisets, so that every element must occur as many times in both (see `areEqualAsMultisets`, which chooses how to compare them from the traits of the elements).
 	* @attention Elements of the iterable must support comparison using "==".
 	* @tparam IterableT The type of the iterables to be compared.
 	* @param[in] lhs The left-hand-side of the equality.
@@ -411,31 +853,12 @@ namespace m0st4fa::utility {
 				return false;
 			}
 
+			// if we reach here, it means the two iterables are not `not-equal`
+			// hence they must be equal
+			return true;
 		}
-		else {
-			// if there exists at least a single element in `lhs`
-			// that does not exist in `rhs`, they are not equal
-			for (size_t i = 0; i < lhsSize; i++) {
-				const auto& lhsElement = lhs.at(i);
-
-				for (size_t j = 0; j < rhsSize; j++) {
-					const auto& rhsElement = rhs.at(j);
-
-					// if the current elements are not equal, the two sets are unequal
-					if (lhsElement == rhsElement)
-						break;
-
-
-					if (j == rhsSize - 1)
-						return false;
-				}
-
-			}
-		}
-
-		// if we reach here, it means the two iterables are not `not-equal`
-		// hence they must be equal
-		return true;
+		else
+			return areEqualAsMultisets(lhs, rhs);
 	}
 
 }
@@ -0,0 +1,165 @@
+#include "utility/AsyncLogWriter.h"
+#include "utility/LoggerMetrics.h"
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF AsyncLogWriter FUNCTIONS
+
+	/**
+	 * @brief Starts the writer thread.
+	 * @param[in] options The capacity of the queue, the maximum size of a batch and the overflow policy.
+	 */
+	AsyncLogWriter::AsyncLogWriter(const AsyncLoggerOptions& options)
+		: m_Queue(options.queueCapacity), m_Options(options)
+	{
+		m_Thread = std::thread{ &AsyncLogWriter::run, this };
+	}
+
+	/**
+	 * @brief Writes every queued record and joins the writer thread.
+	 */
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		m_Stop.store(true, std::memory_order_seq_cst);
+		this->wake(true);
+
+		if (m_Thread.joinable())
+			m_Thread.join();
+	}
+
+	/**
+	 * @brief Queues a record to be written by the writer thread.
+	 * @details If the queue is full, the overflow policy decides whether to wait, to drop `record` or to drop the oldest queued record.
+	 * @param[in] record The record to be written.
+	 */
+	void AsyncLogWriter::push(LogRecord&& record)
+	{
+		while (!m_Queue.tryPush(std::move(record))) {
+
+			switch (m_Options.overflowPolicy) {
+				case OVERFLOW_POLICY::OP_DROP_NEWEST:
+					if (LoggerMetrics::isEnabled())
+						LoggerMetrics::recordDropped(record.level);
+
+					m_Dropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				case OVERFLOW_POLICY::OP_DROP_OLDEST: {
+					LogRecord oldest;
+
+					if (m_Queue.tryPop(oldest)) {
+						if (LoggerMetrics::isEnabled())
+							LoggerMetrics::recordDropped(oldest.level);
+
+						m_Dropped.fetch_add(1, std::memory_order_relaxed);
+					}
+
+					break;
+				}
+				case OVERFLOW_POLICY::OP_BLOCK:
+				default:
+					this->wake(true);
+					std::this_thread::yield();
+					break;
+			}
+
+		}
+
+		this->wake();
+	}
+
+	/**
+	 * @brief Blocks until every record queued before the call has been written or dropped.
+	 * @details The position in the queue after the last queued record is taken as a ticket, and the writer thread is waited for until it has passed that position (see `pass`). Records dropped without being queued, or queued after the call, cannot end the wait early.
+	 */
+	void AsyncLogWriter::flush()
+	{
+		const size_t ticket = m_Queue.pushCount();
+
+		// the writer thread would wait for itself
+		if (std::this_thread::get_id() == m_Thread.get_id())
+			return;
+
+		this->wake(true);
+
+		for (size_t passed = m_Passed.load(std::memory_order_acquire); passed < ticket; passed = m_Passed.load(std::memory_order_acquire))
+			m_Passed.wait(passed, std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Wakes the writer thread up.
+	 * @param[in] force Whether to notify the writer thread even if it does not seem to be sleeping.
+	 */
+	void AsyncLogWriter::wake(bool force)
+	{
+		m_Signal.fetch_add(1, std::memory_order_seq_cst);
+
+		if (force || m_Sleeping.load(std::memory_order_seq_cst))
+			m_Signal.notify_one();
+	}
+
+	/**
+	 * @brief Publishes the position of the front of the queue to `flush`.
+	 * @details Called by the writer thread only while it holds no popped record unwritten, so every record before the front has been either written by it or popped and dropped by a producer (see `OVERFLOW_POLICY::OP_DROP_OLDEST`).
+	 */
+	void AsyncLogWriter::pass()
+	{
+		const size_t position = m_Queue.popCount();
+
+		if (position == m_Passed.load(std::memory_order_relaxed))
+			return;
+
+		m_Passed.store(position, std::memory_order_release);
+		m_Passed.notify_all();
+	}
+
+	/**
+	 * @brief The body of the writer thread.
+	 */
+	void AsyncLogWriter::run()
+	{
+		std::vector<LogRecord> batch;
+		batch.reserve(m_Options.batchSize);
+
+		LogRecord record;
+
+		while (true) {
+
+			while (batch.size() < m_Options.batchSize && m_Queue.tryPop(record))
+				batch.push_back(std::move(record));
+
+			if (!batch.empty()) {
+				this->writeBatch(batch);
+				batch.clear();
+				this->pass();
+				continue;
+			}
+
+			this->pass();
+
+			// the queue has been drained
+			if (m_Stop.load(std::memory_order_seq_cst))
+				break;
+
+			// sleep until a producer signals; the queue is checked again after announcing the sleep so that a push is never missed
+			const uint32_t signal = m_Signal.load(std::memory_order_seq_cst);
+			m_Sleeping.store(true, std::memory_order_seq_cst);
+
+			if (m_Queue.sizeApprox() == 0 && !m_Stop.load(std::memory_order_seq_cst))
+				m_Signal.wait(signal, std::memory_order_seq_cst);
+
+			m_Sleeping.store(false, std::memory_order_relaxed);
+		}
+
+	}
+
+	/**
+	 * @brief Writes a batch of records to every sink of the `Logger`.
+	 * @param[in] batch The records to be written, in the order they were queued.
+	 */
+	void AsyncLogWriter::writeBatch(const std::vector<LogRecord>& batch)
+	{
+		Logger::writeToSinks(batch);
+	}
+
+}
@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "fmt/args.h"
+#include "utility/BinaryLogger.h"
+
+// BINARY LOGGER STATE
+namespace m0st4fa {
+
+	namespace {
+
+		constexpr size_t THREAD_BUFFER_SIZE = 64 * 1024;
+
+		/**
+		 * @brief The records of one thread that have not been written to the log file yet.
+		 * @details The mutex is only contended while another thread flushes every buffer.
+		 */
+		struct ThreadBuffer {
+			std::mutex mutex{};
+			std::vector<char> data = std::vector<char>(THREAD_BUFFER_SIZE);
+			size_t size = 0;
+		};
+
+		struct BinaryLoggerState {
+			std::mutex fileMutex{};
+			std::FILE* file = nullptr;
+
+			std::mutex registryMutex{};
+			std::vector<BinaryCallsite> callsites{};
+
+			std::mutex buffersMutex{};
+			std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+
+			~BinaryLoggerState() {
+				BinaryLogger::close();
+			}
+		};
+
+		BinaryLoggerState& getState() {
+			static BinaryLoggerState state;
+			return state;
+		}
+
+		// the caller must hold `fileMutex`
+		void writeToFile(BinaryLoggerState& state, const char* data, size_t size) {
+			if (state.file && size)
+				std::fwrite(data, 1, size, state.file);
+		}
+
+		// the caller must hold the mutex of `buffer`
+		void flushBuffer(BinaryLoggerState& state, ThreadBuffer& buffer) {
+			std::lock_guard lock{ state.fileMutex };
+
+			writeToFile(state, buffer.data.data(), buffer.size);
+			buffer.size = 0;
+		}
+
+		// the caller must hold `fileMutex`
+		void writeCallsite(BinaryLoggerState& state, const BinaryCallsite& callsite) {
+			std::string record;
+
+			auto append = [&record](const auto& value) {
+				record.append((const char*)&value, sizeof(value));
+				};
+
+			auto appendString = [&record, &append](const std::string& str) {
+				append((uint32_t)str.size());
+				record += str;
+				};
+
+			append(BINARY_RECORD_TYPE::BR_CALLSITE);
+			append(callsite.id);
+			append((uint8_t)callsite.level);
+			append(callsite.line);
+			append(callsite.column);
+			appendString(callsite.fileName);
+			appendString(callsite.functionName);
+			appendString(callsite.format);
+
+			writeToFile(state, record.data(), record.size());
+		}
+
+		/**
+		 * @brief Registers the buffer of the current thread, and writes it when the thread exits.
+		 */
+		struct ThreadBufferHandle {
+			std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+
+			ThreadBufferHandle() {
+				BinaryLoggerState& state = getState();
+				std::lock_guard lock{ state.buffersMutex };
+
+				state.buffers.push_back(buffer);
+			}
+
+			~ThreadBufferHandle() {
+				BinaryLoggerState& state = getState();
+				std::lock_guard lock{ state.buffersMutex };
+
+				{
+					std::lock_guard bufferLock{ buffer->mutex };
+					flushBuffer(state, *buffer);
+				}
+
+				std::erase(state.buffers, buffer);
+			}
+		};
+
+		thread_local ThreadBufferHandle t_Buffer;
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF BinaryLogger FUNCTIONS
+
+	/**
+	 * @brief Opens (truncating) the binary log file, closing the current one first.
+	 * @param[in] path The path of the log file.
+	 * @return `true` if the file has been opened; `false` otherwise.
+	 */
+	bool BinaryLogger::open(const std::string& path)
+	{
+		close();
+
+		BinaryLoggerState& state = getState();
+		std::lock_guard registryLock{ state.registryMutex };
+		std::lock_guard fileLock{ state.fileMutex };
+
+		state.file = std::fopen(path.c_str(), "wb");
+
+		if (!state.file)
+			return false;
+
+		writeToFile(state, MAGIC, sizeof(MAGIC));
+
+		// callsites registered before the file was opened
+		for (const BinaryCallsite& callsite : state.callsites)
+			writeCallsite(state, callsite);
+
+		s_Open.store(true, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief Writes every buffered record and closes the binary log file.
+	 */
+	void BinaryLogger::close()
+	{
+		if (!s_Open.exchange(false, std::memory_order_acq_rel))
+			return;
+
+		flush();
+
+		BinaryLoggerState& state = getState();
+		std::lock_guard lock{ state.fileMutex };
+
+		std::fclose(state.file);
+		state.file = nullptr;
+	}
+
+	/**
+	 * @brief Writes the buffered records of every thread to the log file.
+	 */
+	void BinaryLogger::flush()
+	{
+		BinaryLoggerState& state = getState();
+		std::lock_guard lock{ state.buffersMutex };
+
+		for (const std::shared_ptr<ThreadBuffer>& buffer : state.buffers) {
+			std::lock_guard bufferLock{ buffer->mutex };
+			flushBuffer(state, *buffer);
+		}
+
+		std::lock_guard fileLock{ state.fileMutex };
+
+		if (state.file)
+			std::fflush(state.file);
+	}
+
+	/**
+	 * @brief Registers a callsite, writing its description to the log file once.
+	 * @param[in] level The level of the messages of the callsite.
+	 * @param[in] format The format string of the messages of the callsite.
+	 * @param[in] location The location of the callsite.
+	 * @return The ID messages of the callsite are recorded with.
+	 */
+	uint32_t BinaryLogger::registerCallsite(LOG_LEVEL level, const char* format, std::source_location location)
+	{
+		BinaryLoggerState& state = getState();
+		std::lock_guard lock{ state.registryMutex };
+
+		const BinaryCallsite& callsite = state.callsites.emplace_back(BinaryCallsite{
+			(uint32_t)state.callsites.size(),
+			level,
+			(uint32_t)location.line(),
+			(uint32_t)location.column(),
+			location.file_name(),
+			location.function_name(),
+			format
+			});
+
+		std::lock_guard fileLock{ state.fileMutex };
+		writeCallsite(state, callsite);
+
+		return callsite.id;
+	}
+
+	/**
+	 * @brief Reserves `size` bytes in the buffer of the current thread, locking it until `commit` is called.
+	 * @return A pointer to the reserved bytes, or `nullptr` if no log file is open (in which case nothing is locked).
+	 */
+	char* BinaryLogger::reserve(size_t size)
+	{
+		ThreadBuffer& buffer = *t_Buffer.buffer;
+		buffer.mutex.lock();
+
+		if (!isOpen()) {
+			buffer.mutex.unlock();
+			return nullptr;
+		}
+
+		if (buffer.size + size > buffer.data.size()) {
+			flushBuffer(getState(), buffer);
+
+			if (size > buffer.data.size())
+				buffer.data.resize(size);
+		}
+
+		return buffer.data.data() + buffer.size;
+	}
+
+	/**
+	 * @brief Marks the bytes up to `end` as written and unlocks the buffer of the current thread.
+	 */
+	void BinaryLogger::commit(char* end)
+	{
+		ThreadBuffer& buffer = *t_Buffer.buffer;
+
+		buffer.size = (size_t)(end - buffer.data.data());
+		buffer.mutex.unlock();
+	}
+
+	int64_t BinaryLogger::getTimestamp()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	// IMPLEMENTATIONS OF BinaryLogDecoder FUNCTIONS
+
+	namespace {
+
+		template <typename T>
+		bool read(std::istream& in, T& value) {
+			return (bool)in.read((char*)&value, sizeof(value));
+		}
+
+		bool readString(std::istream& in, std::string& str) {
+			uint32_t size;
+
+			if (!read(in, size))
+				return false;
+
+			str.resize(size);
+
+			return (bool)in.read(str.data(), size);
+		}
+
+	}
+
+	/**
+	 * @brief Decodes a binary log written by `BinaryLogger`.
+	 * @details Decoding stops silently at a truncated record, which is what a log of a crashed process ends with.
+	 * @param[in] in The binary log.
+	 * @param[out] out The stream the text is written to.
+	 * @param[in] options How the text is decorated.
+	 * @return The number of decoded messages.
+	 * @throws ConversionError if `in` is not a binary log, or holds an unknown record type, argument type or log level.
+	 */
+	size_t BinaryLogDecoder::decode(std::istream& in, std::ostream& out, const BinaryLogDecoderOptions& options)
+	{
+		char magic[sizeof(BinaryLogger::MAGIC)];
+
+		if (!in.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(BinaryLogger::MAGIC)))
+			throw utility::ConversionError{ "The input is not a binary log." };
+
+		size_t messageCount = 0;
+		BINARY_RECORD_TYPE recordType;
+
+		while (read(in, recordType)) {
+
+			if (recordType == BINARY_RECORD_TYPE::BR_CALLSITE) {
+				BinaryCallsite callsite;
+				uint8_t level;
+
+				if (!read(in, callsite.id) || !read(in, level) || !read(in, callsite.line) || !read(in, callsite.column) ||
+					!readString(in, callsite.fileName) || !readString(in, callsite.functionName) || !readString(in, callsite.format))
+					break;
+
+				// a corrupt level would only be rejected once formatted, by `Logger::getLevelString`
+				if (level >= (uint8_t)LOG_LEVEL::LL_LOG_LEVEL_COUNT)
+					throw utility::ConversionError{ fmt::format("Unknown log level `{}` of binary log callsite `{}`.", (int)level, callsite.id) };
+
+				callsite.level = (LOG_LEVEL)level;
+				m_Callsites[callsite.id] = std::move(callsite);
+				continue;
+			}
+
+			if (recordType != BINARY_RECORD_TYPE::BR_MESSAGE)
+				throw utility::ConversionError{ fmt::format("Unknown binary log record type `{}`.", (int)recordType) };
+
+			uint32_t id;
+			int64_t timestamp;
+			uint8_t argCount;
+
+			if (!read(in, id) || !read(in, timestamp) || !read(in, argCount))
+				break;
+
+			fmt::dynamic_format_arg_store<fmt::format_context> args;
+			bool truncated = false;
+
+			for (uint8_t i = 0; i < argCount && !truncated; i++) {
+				BINARY_ARG_TYPE type;
+				truncated = !read(in, type);
+
+				if (truncated)
+					break;
+
+				switch (type) {
+					case BINARY_ARG_TYPE::BA_BOOL: {
+						char value;
+						truncated = !read(in, value);
+						args.push_back((bool)value);
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_CHAR: {
+						char value;
+						truncated = !read(in, value);
+						args.push_back(value);
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_INT64: {
+						int64_t value;
+						truncated = !read(in, value);
+						args.push_back(value);
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_UINT64: {
+						uint64_t value;
+						truncated = !read(in, value);
+						args.push_back(value);
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_DOUBLE: {
+						double value;
+						truncated = !read(in, value);
+						args.push_back(value);
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_STRING: {
+						std::string value;
+						truncated = !readString(in, value);
+						args.push_back(std::move(value));
+						break;
+					}
+					case BINARY_ARG_TYPE::BA_POINTER: {
+						uint64_t value;
+						truncated = !read(in, value);
+						args.push_back((const void*)(uintptr_t)value);
+						break;
+					}
+					default:
+						throw utility::ConversionError{ fmt::format("Unknown binary log argument type `{}`.", (int)type) };
+				}
+
+			}
+
+			if (truncated)
+				break;
+
+			// format the message
+			const auto it = m_Callsites.find(id);
+			LogRecord record;
+
+			if (it == m_Callsites.end())
+				record.message = fmt::format("<unknown callsite {}>", id);
+			else {
+				const BinaryCallsite& callsite = it->second;
+				record.level = callsite.level;
+
+				try {
+					record.message = fmt::vformat(callsite.format, args);
+				}
+				catch (const fmt::format_error& error) {
+					record.message = fmt::format("<cannot format `{}`: {}>", callsite.format, error.what());
+				}
+
+				if (options.locations)
+					record.location = fmt::format("\nFile Name: {}\nLine: {}, Character: {}\nFunction: {}\n", callsite.fileName, callsite.line, callsite.column, callsite.functionName);
+			}
+
+			if (options.timestamps)
+				out << fmt::format("{}.{:09} ", timestamp / 1'000'000'000, timestamp % 1'000'000'000);
+
+			out << Logger::format(record, options.color);
+
+			messageCount++;
+		}
+
+		return messageCount;
+	}
+
+}
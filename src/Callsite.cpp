@@ -0,0 +1,178 @@
+#include <deque>
+#include <mutex>
+
+#include "utility/Callsite.h"
+#include "utility/Logger.h"
+
+// CALLSITE REGISTRY STATE
+namespace m0st4fa {
+
+	namespace {
+
+		enum class CALLSITE_RULE_KIND {
+			CR_ALL,
+			CR_FILE,
+			CR_FUNCTION,
+		};
+
+		struct CallsiteRule {
+			CALLSITE_RULE_KIND kind;
+			std::string pattern;
+			bool enabled;
+
+			/**
+			 * @brief Files match by suffix (so that a bare file name matches its full path) and functions by substring (since function names are full signatures).
+			 */
+			bool matches(const Callsite& callsite) const {
+				switch (kind) {
+					case CALLSITE_RULE_KIND::CR_FILE:
+						return std::string_view{ callsite.location.file_name() }.ends_with(pattern);
+					case CALLSITE_RULE_KIND::CR_FUNCTION:
+						return std::string_view{ callsite.location.function_name() }.find(pattern) != std::string_view::npos;
+					default:
+						return true;
+				}
+			}
+		};
+
+		struct CallsiteRegistryState {
+			std::mutex mutex{};
+			std::deque<Callsite> callsites{};	// a deque never moves its elements
+			std::vector<CallsiteRule> rules{};
+		};
+
+		CallsiteRegistryState& getState() {
+			static CallsiteRegistryState state;
+			return state;
+		}
+
+		size_t applyRule(CallsiteRegistryState& state, CallsiteRule&& rule) {
+			size_t count = 0;
+
+			for (Callsite& callsite : state.callsites)
+				if (rule.matches(callsite)) {
+					callsite.enabled.store(rule.enabled, std::memory_order_relaxed);
+					count++;
+				}
+
+			// a rule for everything supersedes every earlier rule
+			if (rule.kind == CALLSITE_RULE_KIND::CR_ALL)
+				state.rules.clear();
+
+			state.rules.push_back(std::move(rule));
+
+			return count;
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF CallsiteRegistry FUNCTIONS
+
+	/**
+	 * @brief Registers a callsite, rendering its location once and applying the file and function rules set so far.
+	 * @param[in] level The level of the messages of the callsite.
+	 * @param[in] location The location of the callsite.
+	 * @return The descriptor of the callsite, which lives as long as the program.
+	 */
+	Callsite& CallsiteRegistry::registerCallsite(LOG_LEVEL level, std::source_location location)
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		Callsite& callsite = state.callsites.emplace_back();
+
+		callsite.id = state.callsites.size() - 1;
+		callsite.level = level;
+		callsite.location = location;
+		callsite.renderedLocation = Logger{}.getCurrSourceLocation(location);
+
+		for (const CallsiteRule& rule : state.rules)
+			if (rule.matches(callsite))
+				callsite.enabled.store(rule.enabled, std::memory_order_relaxed);
+
+		return callsite;
+	}
+
+	/**
+	 * @return The callsites registered so far, in order of registration (their IDs).
+	 */
+	std::vector<const Callsite*> CallsiteRegistry::getCallsites()
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		std::vector<const Callsite*> callsites;
+		callsites.reserve(state.callsites.size());
+
+		for (const Callsite& callsite : state.callsites)
+			callsites.push_back(&callsite);
+
+		return callsites;
+	}
+
+	/**
+	 * @brief Switches a single callsite on or off.
+	 * @param[in] id The ID of the callsite.
+	 * @param[in] enabled Whether the callsite should log.
+	 * @return `true` if the callsite exists; `false` otherwise.
+	 */
+	bool CallsiteRegistry::setEnabled(size_t id, bool enabled)
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		if (id >= state.callsites.size())
+			return false;
+
+		state.callsites[id].enabled.store(enabled, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	/**
+	 * @brief Switches every callsite of a file on or off, including those registered later.
+	 * @param[in] file The file name, or a suffix of its path.
+	 * @param[in] enabled Whether the callsites should log.
+	 * @return The number of registered callsites switched.
+	 */
+	size_t CallsiteRegistry::setFileEnabled(std::string_view file, bool enabled)
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		return applyRule(state, { CALLSITE_RULE_KIND::CR_FILE, std::string{ file }, enabled });
+	}
+
+	/**
+	 * @brief Switches every callsite of a function on or off, including those registered later.
+	 * @param[in] function The function name, or any part of its signature.
+	 * @param[in] enabled Whether the callsites should log.
+	 * @return The number of registered callsites switched.
+	 */
+	size_t CallsiteRegistry::setFunctionEnabled(std::string_view function, bool enabled)
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		return applyRule(state, { CALLSITE_RULE_KIND::CR_FUNCTION, std::string{ function }, enabled });
+	}
+
+	/**
+	 * @brief Switches every callsite on or off, including those registered later, and forgets the file and function rules.
+	 * @param[in] enabled Whether the callsites should log.
+	 * @return The number of registered callsites switched.
+	 */
+	size_t CallsiteRegistry::setAllEnabled(bool enabled)
+	{
+		CallsiteRegistryState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		return applyRule(state, { CALLSITE_RULE_KIND::CR_ALL, std::string{}, enabled });
+	}
+
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <thread>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "utility/ColumnOccupancy.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	namespace {
+
+		/**
+		 * @brief ORs `rowCount` consecutive bitmaps of `wordCount` words into `result`, a register's worth of words at a time.
+		 */
+		void orRows(uint64_t* result, const uint64_t* rows, size_t rowCount, size_t wordCount)
+		{
+			for (size_t row = 0; row < rowCount; row++, rows += wordCount) {
+				size_t word = 0;
+
+#if defined(__AVX2__)
+				for (; word + 4 <= wordCount; word += 4) {
+					const __m256i bits = _mm256_loadu_si256((const __m256i*)(rows + word));
+					_mm256_storeu_si256((__m256i*)(result + word), _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(result + word)), bits));
+				}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+				for (; word + 2 <= wordCount; word += 2) {
+					const __m128i bits = _mm_loadu_si128((const __m128i*)(rows + word));
+					_mm_storeu_si128((__m128i*)(result + word), _mm_or_si128(_mm_loadu_si128((const __m128i*)(result + word)), bits));
+				}
+#endif
+
+				for (; word < wordCount; word++)
+					result[word] |= rows[word];
+			}
+		}
+
+	}
+
+	// IMPLEMENTATIONS OF ColumnOccupancyIndex FUNCTIONS
+
+	/**
+	 * @brief Splits the rows into contiguous chunks of at least `MIN_ROWS_PER_THREAD` rows and calls `f` with the bounds of each one, on separate threads. The first chunk is processed on the calling thread.
+	 */
+	void ColumnOccupancyIndex::forEachChunk(size_t threadCount, const std::function<void(size_t, size_t)>& f) const
+	{
+		if (!threadCount)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		const size_t chunkCount = std::clamp<size_t>(m_RowCount / MIN_ROWS_PER_THREAD, 1, threadCount);
+
+		std::vector<std::thread> threads;
+		threads.reserve(chunkCount - 1);
+
+		for (size_t chunk = 1; chunk < chunkCount; chunk++)
+			threads.emplace_back(f, m_RowCount * chunk / chunkCount, m_RowCount * (chunk + 1) / chunkCount);
+
+		f(0, m_RowCount / chunkCount);
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	/**
+	 * @brief Computes the union of the row bitmaps: each chunk of rows is ORed into its own partial union, and the partial unions into the result.
+	 */
+	void ColumnOccupancyIndex::combineRows(size_t threadCount)
+	{
+		std::vector<std::vector<uint64_t>> partials;
+		std::mutex mutex;
+
+		m_Columns.assign(m_WordCount, 0);
+
+		forEachChunk(threadCount, [this, &partials, &mutex](size_t first, size_t last) {
+			std::vector<uint64_t> partial(m_WordCount, 0);
+			orRows(partial.data(), m_Rows.data() + first * m_WordCount, last - first, m_WordCount);
+
+			std::lock_guard lock{ mutex };
+			partials.push_back(std::move(partial));
+			});
+
+		for (const std::vector<uint64_t>& partial : partials)
+			orRows(m_Columns.data(), partial.data(), 1, m_WordCount);
+	}
+
+	/**
+	 * @return The number of columns occupied in any row.
+	 */
+	size_t ColumnOccupancyIndex::countOccupiedColumns() const
+	{
+		size_t count = 0;
+
+		for (const uint64_t word : m_Columns)
+			count += (size_t)std::popcount(word);
+
+		return count;
+	}
+
+	/**
+	 * @return The indices of the columns occupied in any row, in ascending order.
+	 */
+	std::vector<size_t> ColumnOccupancyIndex::getOccupiedColumns() const
+	{
+		std::vector<size_t> columns;
+		columns.reserve(countOccupiedColumns());
+
+		forEachOccupiedColumn([&columns](size_t column) {
+			columns.push_back(column);
+			});
+
+		return columns;
+	}
+
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utility/FlightRecorder.h"
+#include "utility/Logger.h"
+
+// FLIGHT RECORDER STATE
+namespace m0st4fa {
+
+	namespace {
+
+		/**
+		 * @brief The ring of slots of a single thread. Only the owning thread writes it.
+		 */
+		struct ThreadFlightBuffer {
+			FlightRecorder::Slot slots[FlightRecorder::SLOT_COUNT];
+			uint64_t next = 0;
+			size_t threadIndex = 0;
+		};
+
+		// the buffers of this many exited threads are kept for dumps
+		constexpr size_t RETIRED_BUFFER_COUNT = 16;
+
+		struct FlightRecorderState {
+			std::mutex mutex{};
+			std::vector<std::shared_ptr<ThreadFlightBuffer>> buffers{};
+			std::deque<std::shared_ptr<ThreadFlightBuffer>> retired{};
+			size_t threadCount = 0;
+		};
+
+		FlightRecorderState& getState() {
+			static FlightRecorderState state;
+			return state;
+		}
+
+		/**
+		 * @brief Registers the ring of the current thread, and retires it when the thread exits.
+		 */
+		struct ThreadFlightBufferHandle {
+			std::shared_ptr<ThreadFlightBuffer> buffer = std::make_shared<ThreadFlightBuffer>();
+
+			ThreadFlightBufferHandle() {
+				FlightRecorderState& state = getState();
+				std::lock_guard lock{ state.mutex };
+
+				buffer->threadIndex = state.threadCount++;
+				state.buffers.push_back(buffer);
+			}
+
+			~ThreadFlightBufferHandle() {
+				FlightRecorderState& state = getState();
+				std::lock_guard lock{ state.mutex };
+
+				std::erase(state.buffers, buffer);
+				state.retired.push_back(buffer);
+
+				if (state.retired.size() > RETIRED_BUFFER_COUNT)
+					state.retired.pop_front();
+			}
+		};
+
+		ThreadFlightBuffer& getThreadBuffer() {
+			thread_local ThreadFlightBufferHandle handle;
+			return *handle.buffer;
+		}
+
+		int64_t getNanoseconds() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		struct DumpedRecord {
+			int64_t timestamp;
+			size_t threadIndex;
+			LOG_LEVEL level;
+			std::string text;
+		};
+
+		// the caller must hold the state mutex
+		void collect(const ThreadFlightBuffer& buffer, std::vector<DumpedRecord>& records) {
+			for (const FlightRecorder::Slot& slot : buffer.slots) {
+				const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+
+				// empty or being written
+				if (before == 0 || before % 2)
+					continue;
+
+				DumpedRecord record{ slot.timestamp, buffer.threadIndex, (LOG_LEVEL)slot.level, std::string(slot.text, std::min<size_t>(slot.size, FlightRecorder::TEXT_SIZE)) };
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				// overwritten while being copied
+				if (slot.sequence.load(std::memory_order_relaxed) != before)
+					continue;
+
+				records.push_back(std::move(record));
+			}
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF FlightRecorder FUNCTIONS
+
+	/**
+	 * @brief Claims the next (oldest) slot of the current thread and marks it as being written.
+	 */
+	FlightRecorder::Slot& FlightRecorder::beginSlot(LOG_LEVEL level)
+	{
+		ThreadFlightBuffer& buffer = getThreadBuffer();
+		Slot& slot = buffer.slots[buffer.next++ % SLOT_COUNT];
+
+		slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.timestamp = getNanoseconds();
+		slot.level = (uint8_t)level;
+
+		return slot;
+	}
+
+	/**
+	 * @brief Publishes a slot written by `beginSlot` and `size` bytes of text.
+	 */
+	void FlightRecorder::endSlot(Slot& slot, size_t size)
+	{
+		slot.size = (uint16_t)std::min(size, TEXT_SIZE);
+		slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Copies a message into the next slot of the current thread, truncating it to `TEXT_SIZE` bytes.
+	 * @param[in] level The level of the message.
+	 * @param[in] message The message.
+	 */
+	void FlightRecorder::record(LOG_LEVEL level, std::string_view message)
+	{
+		Slot& slot = beginSlot(level);
+		const size_t size = std::min(message.size(), TEXT_SIZE);
+
+		std::memcpy(slot.text, message.data(), size);
+		endSlot(slot, size);
+	}
+
+	/**
+	 * @brief Writes the recorded messages of every thread in chronological order.
+	 * @details Each message is prefixed with its time relative to the oldest one and the index of its thread.
+	 * @param[out] out The stream to write to.
+	 * @return The number of messages written.
+	 */
+	size_t FlightRecorder::dump(std::ostream& out)
+	{
+		FlightRecorderState& state = getState();
+		std::vector<DumpedRecord> records;
+
+		{
+			std::lock_guard lock{ state.mutex };
+
+			for (const auto& buffer : state.retired)
+				collect(*buffer, records);
+
+			for (const auto& buffer : state.buffers)
+				collect(*buffer, records);
+		}
+
+		std::stable_sort(records.begin(), records.end(), [](const DumpedRecord& lhs, const DumpedRecord& rhs) {
+			return lhs.timestamp < rhs.timestamp;
+			});
+
+		std::string text = std::format("[FLIGHT RECORDER]: {} messages, oldest first\n", records.size());
+
+		for (const DumpedRecord& record : records) {
+			const int64_t elapsed = record.timestamp - records.front().timestamp;
+			const char* level = record.level < LOG_LEVEL::LL_LOG_LEVEL_COUNT ? Logger::getLevelString(record.level) : "?";
+
+			text += std::format("+{}.{:06}s T{} [{:s}]: {:s}\n", elapsed / 1'000'000'000, elapsed / 1'000 % 1'000'000, record.threadIndex, level, record.text);
+		}
+
+		out.write(text.data(), (std::streamsize)text.size());
+		out.flush();
+
+		return records.size();
+	}
+
+	/**
+	 * @brief Forgets the messages recorded by every thread.
+	 * @attention Must not be called while other threads are recording.
+	 */
+	void FlightRecorder::clear()
+	{
+		FlightRecorderState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		state.retired.clear();
+
+		for (const auto& buffer : state.buffers)
+			for (Slot& slot : buffer->slots)
+				slot.sequence.store(0, std::memory_order_relaxed);
+	}
+
+}
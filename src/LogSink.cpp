@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <fcntl.h>
+#include <ostream>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "utility/LogSink.h"
+
+// PLATFORM
+namespace m0st4fa {
+
+	namespace {
+
+		int openFile(const std::string& path, bool append) {
+#ifdef _WIN32
+			const int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+			return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+			const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+			return ::open(path.c_str(), flags, 0644);
+#endif
+		}
+
+		/**
+		 * @brief Writes `size` bytes, retrying interrupted and partial writes.
+		 * @return The number of bytes written; less than `size` if a write failed.
+		 */
+		size_t writeFile(int fd, const char* data, size_t size) {
+			size_t total = 0;
+
+			while (total < size) {
+#ifdef _WIN32
+				const int written = _write(fd, data + total, (unsigned int)std::min<size_t>(size - total, 1u << 30));
+#else
+				const ssize_t written = ::write(fd, data + total, size - total);
+#endif
+
+				if (written < 0 && errno == EINTR)
+					continue;
+
+				if (written <= 0)
+					break;
+
+				total += (size_t)written;
+			}
+
+			return total;
+		}
+
+		void syncFile(int fd) {
+#if defined(_WIN32)
+			_commit(fd);
+#elif defined(__APPLE__)
+			fsync(fd);
+#else
+			fdatasync(fd);
+#endif
+		}
+
+		void closeFile(int fd) {
+#ifdef _WIN32
+			_close(fd);
+#else
+			::close(fd);
+#endif
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF ConsoleSink FUNCTIONS
+	void ConsoleSink::write(std::span<const LogRecord> records)
+	{
+		// there are only a few distinct streams; records going to the same stream keep their relative order
+		std::vector<std::pair<std::ostream*, std::string>> buffers;
+
+		for (const LogRecord& record : records) {
+			std::ostream* stream = &Logger::getStream(record.level);
+
+			auto it = std::find_if(buffers.begin(), buffers.end(), [stream](const auto& p) { return p.first == stream; });
+
+			if (it == buffers.end())
+				it = buffers.insert(buffers.end(), { stream, std::string{} });
+
+			it->second += Logger::format(record, m_Color);
+		}
+
+		std::lock_guard lock{ m_Mutex };
+
+		for (const auto& [stream, buffer] : buffers) {
+			stream->write(buffer.data(), (std::streamsize)buffer.size());
+			stream->flush();
+		}
+
+	}
+
+	void ConsoleSink::flush()
+	{
+		std::lock_guard lock{ m_Mutex };
+
+		for (LOG_LEVEL level : { LOG_LEVEL::LL_ERROR, LOG_LEVEL::LL_WARRNING, LOG_LEVEL::LL_INFO })
+			Logger::getStream(level).flush();
+	}
+
+	// IMPLEMENTATIONS OF FileSink FUNCTIONS
+
+	/**
+	 * @brief Opens the log file.
+	 * @param[in] options The path, buffering, rotation and syncing configuration.
+	 * @throws LogSinkError if the file cannot be opened.
+	 */
+	FileSink::FileSink(const FileSinkOptions& options)
+		: m_Options(options)
+	{
+		m_Buffer.reserve(m_Options.bufferSize);
+
+		if (!this->open(m_Options.append))
+			throw LogSinkError{ "Could not open the log file `" + m_Options.path + "`." };
+	}
+
+	FileSink::~FileSink()
+	{
+		std::lock_guard lock{ m_Mutex };
+
+		this->writeOut();
+		this->close();
+	}
+
+	/**
+	 * @return `false` if the file cannot be opened.
+	 */
+	bool FileSink::open(bool append)
+	{
+		m_Fd = openFile(m_Options.path, append);
+
+		if (m_Fd < 0)
+			return false;
+
+		std::error_code error;
+		const auto size = std::filesystem::file_size(m_Options.path, error);
+
+		m_FileSize = (append && !error) ? (size_t)size : 0;
+		m_OpenedAt = m_LastSync = Clock::now();
+
+		return true;
+	}
+
+	void FileSink::close()
+	{
+		if (m_Fd < 0)
+			return;
+
+		if (m_Options.syncInterval.count())
+			syncFile(m_Fd);
+
+		closeFile(m_Fd);
+		m_Fd = -1;
+	}
+
+	/**
+	 * @brief Writes the buffer to the file with a single write, syncing it if the sync interval has elapsed.
+	 * @details Never throws: a failure is counted, and the unwritten part of the buffer is retained (up to `FileSinkOptions::maxRetainedOnError` bytes) or dropped. A file that could not be reopened after a rotation is reopened first.
+	 */
+	void FileSink::writeOut()
+	{
+		if (m_Buffer.empty())
+			return;
+
+		const size_t written = (m_Fd >= 0 || this->open(true)) ? writeFile(m_Fd, m_Buffer.data(), m_Buffer.size()) : 0;
+
+		m_FileSize += written;
+
+		if (written < m_Buffer.size()) {
+			m_FailedWrites.fetch_add(1, std::memory_order_relaxed);
+			m_Buffer.erase(0, written);
+
+			if (m_Buffer.size() > m_Options.maxRetainedOnError) {
+				m_DroppedBytes.fetch_add(m_Buffer.size(), std::memory_order_relaxed);
+				m_Buffer.clear();
+			}
+
+			return;
+		}
+
+		m_Buffer.clear();
+
+		if (m_Options.syncInterval.count()) {
+			const auto now = Clock::now();
+
+			if (now - m_LastSync >= m_Options.syncInterval) {
+				syncFile(m_Fd);
+				m_LastSync = now;
+			}
+		}
+
+	}
+
+	/**
+	 * @brief Renames `path` to `path.1`, shifting the older backups, and starts a new file.
+	 * @details Nothing is rotated while the file cannot be reopened, so that a lasting failure does not shift the backups out one write after another.
+	 */
+	void FileSink::rotate()
+	{
+		namespace fs = std::filesystem;
+
+		this->writeOut();
+
+		// the file could not be reopened since the last rotation: there is nothing to rotate, and the backups are kept
+		if (m_Fd < 0)
+			return;
+
+		this->close();
+
+		std::error_code error;
+		const std::string& path = m_Options.path;
+
+		if (m_Options.maxBackups == 0)
+			fs::remove(path, error);
+		else {
+			fs::remove(path + "." + std::to_string(m_Options.maxBackups), error);
+
+			for (size_t i = m_Options.maxBackups - 1; i > 0; i--)
+				fs::rename(path + "." + std::to_string(i), path + "." + std::to_string(i + 1), error);
+
+			fs::rename(path, path + ".1", error);
+		}
+
+		// on failure, the file is reopened by the next write-out; until then, the new file is not due for rotation
+		m_FileSize = 0;
+		m_OpenedAt = Clock::now();
+		this->open(false);
+	}
+
+	void FileSink::write(std::span<const LogRecord> records)
+	{
+		std::lock_guard lock{ m_Mutex };
+
+		const bool rotateBySize = m_Options.maxFileSize != 0;
+
+		if (m_Options.rotationInterval.count() && Clock::now() - m_OpenedAt >= m_Options.rotationInterval)
+			this->rotate();
+
+		for (const LogRecord& record : records) {
+			const std::string text = Logger::format(record, false);
+
+			if (rotateBySize && m_FileSize + m_Buffer.size() + text.size() > m_Options.maxFileSize && m_FileSize + m_Buffer.size() != 0)
+				this->rotate();
+
+			m_Buffer += text;
+
+			if (m_Buffer.size() >= m_Options.bufferSize)
+				this->writeOut();
+		}
+
+	}
+
+	void FileSink::flush()
+	{
+		std::lock_guard lock{ m_Mutex };
+		this->writeOut();
+	}
+
+}
@@ -1,12 +1,75 @@
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
 #include "utility/Logger.h"
+#include "utility/AsyncLogWriter.h"
+#include "utility/LogSink.h"
+#include "utility/LoggerMetrics.h"
+#include "utility/FlightRecorder.h"
 
 // FUNCTIONS
 namespace m0st4fa {
 
+	// SINKS AND ASYNCHRONOUS MODE STATE
+	namespace {
+
+		/**
+		 * @brief The sinks every `Logger` fans out to; by default, only the console.
+		 */
+		struct SinkRegistry {
+			std::shared_mutex mutex{};
+			std::vector<std::shared_ptr<LogSink>> sinks{ std::make_shared<ConsoleSink>() };
+		};
+
+		SinkRegistry& getSinkRegistry() {
+			static SinkRegistry registry;
+			return registry;
+		}
+
+		/**
+		 * @brief Owns the asynchronous writer, draining it when the program exits.
+		 */
+		struct AsyncWriterHolder {
+			std::unique_ptr<AsyncLogWriter> writer{};
+			std::atomic<AsyncLogWriter*> active{ nullptr };
+			std::mutex mutex{};
+
+			// the sinks must outlive the writer, which drains into them on destruction
+			AsyncWriterHolder() {
+				getSinkRegistry();
+			}
+
+			~AsyncWriterHolder() {
+				active.store(nullptr, std::memory_order_seq_cst);
+				writer.reset();
+			}
+		};
+
+		AsyncWriterHolder& getAsyncWriterHolder() {
+			static AsyncWriterHolder holder;
+			return holder;
+		}
+
+	}
+
 	// IMPLEMENTATIONS OF Logger FUNCTIONS
 	void Logger::log(const LoggerInfo& loggerInfo, const std::string& message, std::source_location location) const
 	{
 
+		if (loggerInfo.level < LOG_LEVEL::LL_FATAL_ERROR || loggerInfo.level >= LOG_LEVEL::LL_LOG_LEVEL_COUNT)
+			throw UnknownLogLevel{};
+
+		// if the level is below the runtime threshold
+		if (!isEnabled(loggerInfo.level)) {
+			if (FlightRecorder::isEnabled())
+				FlightRecorder::record(loggerInfo.level, message);
+
+			return;
+		}
+
 		// if logging a debug message
 		if (loggerInfo.level == LOG_LEVEL::LL_DEBUG) {
 			this->logDebug(message, location);
@@ -14,58 +77,387 @@ namespace m0st4fa {
 		};
 
 		// if logging any other message
-		const std::string logLevelStr = (const char *)LOG_LEVEL_STRING[static_cast<int>(loggerInfo.level)];
-		/*const std::string errorTypeStr = (const char* )ERROR_TYPE_NAMES[static_cast<int>(loggerInfo.info.errorType)];*/
+		LogRecord record{ loggerInfo.level, message };
 
-		std::string messageStr;
+#ifdef _DEBUG 
+#ifdef _TRACE
+		record.location = this->getCurrSourceLocation(location);
+#endif
+#endif
+
+		write(std::move(record));
+	}
+
+#ifdef _DEBUG
+	void Logger::logDebug(const std::string& message, std::source_location location) const
+	{
+		LogRecord record{ LOG_LEVEL::LL_DEBUG, message };
 		
-		if (loggerInfo.level == LOG_LEVEL::LL_ERROR)
-			messageStr += std::format(ANSI_ERR_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, message);
-		else if (loggerInfo.level == LOG_LEVEL::LL_FATAL_ERROR)
-			messageStr += std::format(ANSI_FATAL_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, message);
-		else
-			messageStr += std::format(ANSI_INFO_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, message);
+#ifdef _TRACE
+		record.location = this->getCurrSourceLocation(location);
+#endif
+		
+		write(std::move(record));
+
+		return;
+	}
+#else 
+	void Logger::logDebug(const std::string& message, std::source_location) const
+	{
+		// debug messages are not written in non-debug builds, but the flight recorder keeps them
+		if (FlightRecorder::isEnabled())
+			FlightRecorder::record(LOG_LEVEL::LL_DEBUG, message);
+	};
+#endif
+
+	/**
+	 * @brief Logs a message, limited to the rate `limit` for the callsite of the call.
+	 * @details See the templated `logLimited`. The limit is checked before anything else is done with `message`.
+	 * @param[in] loggerInfo The level of the message.
+	 * @param[in] message The message.
+	 * @param[in] limit The sampling rate and token bucket of the callsite.
+	 * @param[in] location The location of the callsite.
+	 */
+	void Logger::log(const LoggerInfo& loggerInfo, const std::string& message, const RateLimit& limit, std::source_location location) const
+	{
+
+		if (loggerInfo.level < LOG_LEVEL::LL_FATAL_ERROR || loggerInfo.level >= LOG_LEVEL::LL_LOG_LEVEL_COUNT)
+			throw UnknownLogLevel{};
+
+		uint64_t suppressed;
+
+		if (!isEnabled(loggerInfo.level) || !RateLimiter::get(location, loggerInfo.level).tryAcquire(limit, suppressed)) {
+			if (FlightRecorder::isEnabled())
+				FlightRecorder::record(loggerInfo.level, message);
+
+			return;
+		}
+
+		if (suppressed)
+			logSuppressed(loggerInfo.level, location.file_name(), location.line(), suppressed);
+
+		this->log(loggerInfo, message, location);
+	}
+
+	/**
+	 * @brief Logs a summary of the messages a callsite has suppressed.
+	 */
+	void Logger::logSuppressed(LOG_LEVEL level, const char* fileName, uint32_t line, uint64_t count)
+	{
+		write(LogRecord{ level, std::format("{} messages from {}:{} were suppressed by the rate limit.", count, fileName, line) });
+	}
+
+	/**
+	 * @brief Logs a summary for every callsite that has suppressed messages since it last logged.
+	 * @note Called by `flush`, so that suppressed messages are accounted for even if their callsite never logs again.
+	 */
+	void Logger::reportSuppressed()
+	{
+		RateLimiter::forEachSuppressed(&Logger::logSuppressed);
+	}
+
+	/**
+	 * @brief Logs an already formatted message; the out-of-line part of the templated `log` API.
+	 * @details Unlike `logDebug`, debug messages are not discarded in non-debug builds: whether they are logged is decided by `UTILITY_LOG_MIN_LEVEL` at compile time.
+	 * @param[in] level The level of the message.
+	 * @param[in] message The formatted message.
+	 * @param[in] location The location of the logging call.
+	 */
+	void Logger::logFormatted(LOG_LEVEL level, std::string&& message, [[maybe_unused]] std::source_location location) const
+	{
+		LogRecord record{ level, std::move(message) };
+
+#ifdef _DEBUG 
+#ifdef _TRACE
+		record.location = this->getCurrSourceLocation(location);
+#endif
+#endif
+
+		write(std::move(record));
+	}
+
+	/**
+	 * @brief Logs an already formatted message of a registered callsite.
+	 * @param[in] level The level of the message.
+	 * @param[in] message The formatted message.
+	 * @param[in] callsite The descriptor of the callsite, whose pre-rendered location is used when tracing.
+	 */
+	void Logger::logFormatted(LOG_LEVEL level, std::string&& message, [[maybe_unused]] const Callsite& callsite) const
+	{
+		LogRecord record{ level, std::move(message) };
 
 #ifdef _DEBUG 
 #ifdef _TRACE
-		messageStr += this->getCurrSourceLocation(location);
+		record.location = callsite.renderedLocation;
 #endif
 #endif
 
-		switch (loggerInfo.level) {
+		write(std::move(record));
+	}
+
+	/**
+	 * @brief Writes a record synchronously or hands it to the asynchronous writer, depending on the current mode.
+	 * @details The record is also kept by the flight recorder, if it is enabled. A fatal error blocks until every queued record (including itself) has been written, and then dumps the flight recorder to `std::cerr`.
+	 * @param[in] record The record to be written.
+	 */
+	void Logger::write(LogRecord&& record)
+	{
+		if (LoggerMetrics::isEnabled())
+			record.loggedAt = LoggerMetrics::Clock::now();
+
+		const bool recorded = FlightRecorder::isEnabled();
+
+		if (recorded)
+			FlightRecorder::record(record.level, record.message);
+
+		const bool fatal = record.level == LOG_LEVEL::LL_FATAL_ERROR;
+		AsyncLogWriter* writer = getAsyncWriterHolder().active.load(std::memory_order_acquire);
+
+		if (writer) {
+			writer->push(std::move(record));
+
+			if (fatal)
+				writer->flush();
+		}
+		else
+			writeToSinks(std::span<const LogRecord>{ &record, 1 });
+
+		if (fatal && recorded)
+			FlightRecorder::dump(std::cerr);
+	}
+
+	namespace {
+
+		/**
+		 * @brief Appends a record decorated as described in `Logger::format` to `out`, without intermediate strings.
+		 */
+		template <typename String>
+		void appendRecord(String& out, const LogRecord& record, const char* logLevelStr, bool color) {
+			auto it = std::back_inserter(out);
+
+			if (!color) {
+				std::format_to(it, "[{:s}]: {:s}\n", logLevelStr, record.message);
+				out += record.location;
+				return;
+			}
+
+			switch (record.level) {
+				case LOG_LEVEL::LL_ERROR:
+					std::format_to(it, ANSI_ERR_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, record.message);
+					break;
+				case LOG_LEVEL::LL_FATAL_ERROR:
+					std::format_to(it, ANSI_FATAL_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, record.message);
+					break;
+				case LOG_LEVEL::LL_DEBUG:
+					std::format_to(it, ANSI_DEBUG_COLOR"[{:s}]: {:s}" ANSI_RESET_ALL, logLevelStr, record.message);
+					break;
+				default:
+					std::format_to(it, ANSI_INFO_COLOR"[{:s}]: {:s}\n" ANSI_RESET_ALL, logLevelStr, record.message);
+					break;
+			}
+
+			out += record.location;
+			out += "\n";
+		}
+
+	}
+
+	/**
+	 * @brief Decorates a record with its level and, optionally, the ANSI colors of that level.
+	 * @param[in] record The record to be decorated.
+	 * @param[in] color Whether to add ANSI colors. Colored records are followed by an empty line, as on the console; plain records are not.
+	 * @return The text to be written for `record`, including the trailing new line.
+	 */
+	std::string Logger::format(const LogRecord& record, bool color)
+	{
+		std::string messageStr;
+		appendRecord(messageStr, record, getLevelString(record.level), color);
+
+		return messageStr;
+	}
+
+	/**
+	 * @brief Decorates a record (see `format(const LogRecord&, bool)`) into a string allocated from a memory resource.
+	 * @param[in] record The record to be decorated.
+	 * @param[in] resource The memory resource to allocate the result from.
+	 * @param[in] color Whether to add ANSI colors.
+	 * @return The text to be written for `record`.
+	 */
+	std::pmr::string Logger::format(const LogRecord& record, std::pmr::memory_resource* resource, bool color)
+	{
+		std::pmr::string messageStr{ resource };
+		appendRecord(messageStr, record, getLevelString(record.level), color);
+
+		return messageStr;
+	}
+
+	/**
+	 * @param[in] level The level of the message to be written.
+	 * @return The stream messages of `level` are written to.
+	 */
+	std::ostream& Logger::getStream(LOG_LEVEL level)
+	{
+
+		switch (level) {
 			case LOG_LEVEL::LL_FATAL_ERROR:
 			case LOG_LEVEL::LL_ERROR:
-				std::cerr << messageStr << "\n";
-				return;
+				return std::cerr;
 			case LOG_LEVEL::LL_WARRNING:
-				std::cout << messageStr << "\n";
-				return;
+			case LOG_LEVEL::LL_DEBUG:
+				return std::cout;
 			case LOG_LEVEL::LL_INFO:
-				std::clog << messageStr << "\n";
-				return;
+				return std::clog;
 			default:
 				throw UnknownLogLevel{};
 		};
 
 	}
 
-#ifdef _DEBUG
-	void Logger::logDebug(const std::string& message, std::source_location location) const
+	/**
+	 * @brief Switches every `Logger` to asynchronous mode.
+	 * @details Records are pushed into a bounded lock-free queue and written by a dedicated thread in batches. If the logger is already asynchronous, the current writer is drained and replaced by one using `options`.
+	 * @attention Must not be called while other threads are logging.
+	 * @param[in] options The capacity of the queue, the maximum size of a batch and the overflow policy.
+	 */
+	void Logger::enableAsync(const AsyncLoggerOptions& options)
 	{
-		const std::string logLevelStr = (const char* ) LOG_LEVEL_STRING[(int)LOG_LEVEL::LL_DEBUG];
-		std::string messageStr = std::format(ANSI_DEBUG_COLOR"[{:s}]: {:s}" ANSI_RESET_ALL, logLevelStr, message);
-		
-#ifdef _TRACE
-		messageStr += this->getCurrSourceLocation(location);
-#endif
-		
-		std::cout << messageStr << "\n";
+		AsyncWriterHolder& holder = getAsyncWriterHolder();
+		std::lock_guard lock{ holder.mutex };
 
-		return;
+		holder.active.store(nullptr, std::memory_order_seq_cst);
+		holder.writer = std::make_unique<AsyncLogWriter>(options);
+		holder.active.store(holder.writer.get(), std::memory_order_release);
+	}
+
+	/**
+	 * @brief Switches every `Logger` back to synchronous mode, writing every queued record first.
+	 * @attention Must not be called while other threads are logging.
+	 */
+	void Logger::disableAsync()
+	{
+		AsyncWriterHolder& holder = getAsyncWriterHolder();
+		std::lock_guard lock{ holder.mutex };
+
+		holder.active.store(nullptr, std::memory_order_seq_cst);
+		holder.writer.reset();
+	}
+
+	/**
+	 * @return `true` if the logger is in asynchronous mode; `false` otherwise.
+	 */
+	bool Logger::isAsync()
+	{
+		return getAsyncWriterHolder().active.load(std::memory_order_acquire) != nullptr;
+	}
+
+	/**
+	 * @brief Blocks until every record logged before the call has been written (or dropped by the overflow policy).
+	 * @details Pending suppression summaries of rate-limited callsites are logged first, and every sink is flushed afterwards.
+	 */
+	void Logger::flush()
+	{
+		reportSuppressed();
+
+		if (AsyncLogWriter* writer = getAsyncWriterHolder().active.load(std::memory_order_acquire))
+			writer->flush();
+
+		SinkRegistry& registry = getSinkRegistry();
+		std::shared_lock lock{ registry.mutex };
+
+		for (const std::shared_ptr<LogSink>& sink : registry.sinks)
+			sink->flush();
+	}
+
+	/**
+	 * @return The number of records dropped by the overflow policy of the current asynchronous writer.
+	 */
+	size_t Logger::droppedCount()
+	{
+		if (AsyncLogWriter* writer = getAsyncWriterHolder().active.load(std::memory_order_acquire))
+			return writer->droppedCount();
+
+		return 0;
+	}
+
+	/**
+	 * @brief Writes a batch of records to every sink.
+	 * @param[in] records The records to be written, in order.
+	 */
+	void Logger::writeToSinks(std::span<const LogRecord> records)
+	{
+		SinkRegistry& registry = getSinkRegistry();
+		std::shared_lock lock{ registry.mutex };
+
+		for (const std::shared_ptr<LogSink>& sink : registry.sinks)
+			sink->write(records);
+
+		if (LoggerMetrics::isEnabled()) {
+			const auto now = LoggerMetrics::Clock::now();
+
+			for (const LogRecord& record : records)
+				LoggerMetrics::recordWritten(record, now);
+		}
+
+	}
+
+	/**
+	 * @brief Adds a sink every `Logger` writes to, besides the current ones.
+	 * @param[in] sink The sink to be added.
+	 */
+	void Logger::addSink(std::shared_ptr<LogSink> sink)
+	{
+		SinkRegistry& registry = getSinkRegistry();
+		std::unique_lock lock{ registry.mutex };
+
+		registry.sinks.push_back(std::move(sink));
+	}
+
+	/**
+	 * @brief Stops writing to `sink`, flushing it first.
+	 * @param[in] sink The sink to be removed.
+	 */
+	void Logger::removeSink(const std::shared_ptr<LogSink>& sink)
+	{
+		SinkRegistry& registry = getSinkRegistry();
+		std::unique_lock lock{ registry.mutex };
+
+		if (std::erase(registry.sinks, sink))
+			sink->flush();
+	}
+
+	/**
+	 * @brief Replaces every sink with `sinks`.
+	 * @param[in] sinks The sinks to write to from now on. If empty, records are discarded.
+	 */
+	void Logger::setSinks(std::vector<std::shared_ptr<LogSink>> sinks)
+	{
+		SinkRegistry& registry = getSinkRegistry();
+		std::unique_lock lock{ registry.mutex };
+
+		for (const std::shared_ptr<LogSink>& sink : registry.sinks)
+			sink->flush();
+
+		registry.sinks = std::move(sinks);
+	}
+
+	/**
+	 * @brief Goes back to writing only to the console.
+	 */
+	void Logger::resetSinks()
+	{
+		setSinks({ std::make_shared<ConsoleSink>() });
+	}
+
+	/**
+	 * @return The sinks every `Logger` currently writes to.
+	 */
+	std::vector<std::shared_ptr<LogSink>> Logger::getSinks()
+	{
+		SinkRegistry& registry = getSinkRegistry();
+		std::shared_lock lock{ registry.mutex };
+
+		return registry.sinks;
 	}
-#else 
-	void Logger::logDebug(const std::string&, std::source_location) const {};
-#endif
 
 }
 
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tabulate/table.hpp"
+#include "utility/LoggerMetrics.h"
+
+// LOGGER METRICS STATE
+namespace m0st4fa {
+
+	namespace {
+
+		constexpr size_t LEVEL_COUNT = LoggerMetricsSnapshot::LEVEL_COUNT;
+
+		/**
+		 * @brief The counters of a single thread. Only the owning thread writes them.
+		 */
+		struct alignas(utility::CACHE_LINE_SIZE) ThreadMetrics {
+			std::atomic<uint64_t> messages[LEVEL_COUNT]{};
+			std::atomic<uint64_t> bytes[LEVEL_COUNT]{};
+			std::atomic<uint64_t> dropped[LEVEL_COUNT]{};
+			std::atomic<uint64_t> latency[LEVEL_COUNT][LatencyHistogram::BUCKET_COUNT]{};
+
+			void addTo(LoggerMetricsSnapshot& snapshot) const {
+				for (size_t level = 0; level < LEVEL_COUNT; level++) {
+					snapshot.messages[level] += messages[level].load(std::memory_order_relaxed);
+					snapshot.bytes[level] += bytes[level].load(std::memory_order_relaxed);
+					snapshot.dropped[level] += dropped[level].load(std::memory_order_relaxed);
+
+					for (size_t bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; bucket++)
+						snapshot.latency[level].counts[bucket] += latency[level][bucket].load(std::memory_order_relaxed);
+				}
+			}
+		};
+
+		// a single writer can increment without a read-modify-write instruction
+		void increment(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		struct MetricsRegistry {
+			std::mutex mutex{};
+			std::vector<std::shared_ptr<ThreadMetrics>> threads{};
+			LoggerMetricsSnapshot retired{};
+		};
+
+		MetricsRegistry& getMetricsRegistry() {
+			static MetricsRegistry registry;
+			return registry;
+		}
+
+		/**
+		 * @brief Registers the counters of the current thread, and folds them into the retired totals when it exits.
+		 */
+		struct ThreadMetricsHandle {
+			std::shared_ptr<ThreadMetrics> metrics = std::make_shared<ThreadMetrics>();
+
+			ThreadMetricsHandle() {
+				MetricsRegistry& registry = getMetricsRegistry();
+				std::lock_guard lock{ registry.mutex };
+
+				registry.threads.push_back(metrics);
+			}
+
+			~ThreadMetricsHandle() {
+				MetricsRegistry& registry = getMetricsRegistry();
+				std::lock_guard lock{ registry.mutex };
+
+				metrics->addTo(registry.retired);
+				std::erase(registry.threads, metrics);
+			}
+		};
+
+		ThreadMetrics& getThreadMetrics() {
+			thread_local ThreadMetricsHandle handle;
+			return *handle.metrics;
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF LatencyHistogram FUNCTIONS
+
+	/**
+	 * @return The number of recorded values.
+	 */
+	uint64_t LatencyHistogram::getCount() const
+	{
+		uint64_t count = 0;
+
+		for (uint64_t bucketCount : counts)
+			count += bucketCount;
+
+		return count;
+	}
+
+	/**
+	 * @param[in] percentile The percentile, between 0 and 100.
+	 * @return An upper bound of the value below which `percentile` percent of the recorded values fall; 0 if nothing has been recorded.
+	 */
+	uint64_t LatencyHistogram::getPercentile(double percentile) const
+	{
+		const uint64_t count = this->getCount();
+
+		if (!count)
+			return 0;
+
+		const uint64_t rank = std::max<uint64_t>(1, (uint64_t)(std::clamp(percentile, 0.0, 100.0) / 100.0 * (double)count + 0.5));
+		uint64_t seen = 0;
+
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+			seen += counts[bucket];
+
+			if (seen >= rank)
+				return getBucketUpperBound(bucket);
+		}
+
+		return this->getMax();
+	}
+
+	/**
+	 * @return An upper bound of the greatest recorded value; 0 if nothing has been recorded.
+	 */
+	uint64_t LatencyHistogram::getMax() const
+	{
+		for (size_t bucket = BUCKET_COUNT; bucket > 0; bucket--)
+			if (counts[bucket - 1])
+				return getBucketUpperBound(bucket - 1);
+
+		return 0;
+	}
+
+	LatencyHistogram& LatencyHistogram::operator+=(const LatencyHistogram& other)
+	{
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+			counts[bucket] += other.counts[bucket];
+
+		return *this;
+	}
+
+	LatencyHistogram& LatencyHistogram::operator-=(const LatencyHistogram& other)
+	{
+		for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+			counts[bucket] -= std::min(counts[bucket], other.counts[bucket]);
+
+		return *this;
+	}
+
+	// IMPLEMENTATIONS OF LoggerMetricsSnapshot FUNCTIONS
+	LoggerMetricsSnapshot& LoggerMetricsSnapshot::operator-=(const LoggerMetricsSnapshot& other)
+	{
+		for (size_t level = 0; level < LEVEL_COUNT; level++) {
+			messages[level] -= std::min(messages[level], other.messages[level]);
+			bytes[level] -= std::min(bytes[level], other.bytes[level]);
+			dropped[level] -= std::min(dropped[level], other.dropped[level]);
+			latency[level] -= other.latency[level];
+		}
+
+		return *this;
+	}
+
+	/**
+	 * @return The counters accumulated between the snapshot `rhs` and the later snapshot `lhs`.
+	 */
+	LoggerMetricsSnapshot operator-(LoggerMetricsSnapshot lhs, const LoggerMetricsSnapshot& rhs)
+	{
+		return lhs -= rhs;
+	}
+
+	/**
+	 * @brief Renders a metrics snapshot as a table, with a row per level and latencies in nanoseconds.
+	 * @param[in] snapshot The snapshot to be rendered.
+	 * @return The string representation of `snapshot`.
+	 */
+	std::string toString(const LoggerMetricsSnapshot& snapshot)
+	{
+		using namespace tabulate;
+
+		Table table{};
+		table.add_row({ "Level", "Messages", "Bytes", "Dropped", "p50 (ns)", "p99 (ns)", "p99.9 (ns)", "Max (ns)" });
+
+		for (size_t level = 0; level < LEVEL_COUNT; level++) {
+			const LatencyHistogram& latency = snapshot.latency[level];
+
+			table.add_row({
+				Logger::getLevelString((LOG_LEVEL)level),
+				std::to_string(snapshot.messages[level]),
+				std::to_string(snapshot.bytes[level]),
+				std::to_string(snapshot.dropped[level]),
+				std::to_string(latency.getPercentile(50)),
+				std::to_string(latency.getPercentile(99)),
+				std::to_string(latency.getPercentile(99.9)),
+				std::to_string(latency.getMax())
+				});
+		}
+
+		return table.str();
+	}
+
+	// IMPLEMENTATIONS OF LoggerMetrics FUNCTIONS
+
+	/**
+	 * @brief Accounts for a record that has been written by every sink.
+	 * @param[in] record The written record.
+	 * @param[in] writtenAt When the sinks finished writing it.
+	 */
+	void LoggerMetrics::recordWritten(const LogRecord& record, Clock::time_point writtenAt)
+	{
+		const size_t level = (size_t)record.level;
+
+		if (level >= LEVEL_COUNT)
+			return;
+
+		ThreadMetrics& metrics = getThreadMetrics();
+
+		increment(metrics.messages[level]);
+		increment(metrics.bytes[level], record.message.size() + record.location.size());
+
+		if (record.loggedAt != Clock::time_point{}) {
+			const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(writtenAt - record.loggedAt).count();
+			increment(metrics.latency[level][LatencyHistogram::getBucketIndex((uint64_t)std::max<int64_t>(latency, 0))]);
+		}
+
+	}
+
+	/**
+	 * @brief Accounts for a record that has been dropped by the overflow policy.
+	 * @param[in] level The level of the dropped record.
+	 */
+	void LoggerMetrics::recordDropped(LOG_LEVEL level)
+	{
+		if ((size_t)level < LEVEL_COUNT)
+			increment(getThreadMetrics().dropped[(size_t)level]);
+	}
+
+	/**
+	 * @return The counters of every thread, merged.
+	 */
+	LoggerMetricsSnapshot LoggerMetrics::getSnapshot()
+	{
+		MetricsRegistry& registry = getMetricsRegistry();
+		std::lock_guard lock{ registry.mutex };
+
+		LoggerMetricsSnapshot snapshot = registry.retired;
+
+		for (const std::shared_ptr<ThreadMetrics>& metrics : registry.threads)
+			metrics->addTo(snapshot);
+
+		return snapshot;
+	}
+
+}
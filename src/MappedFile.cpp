@@ -0,0 +1,103 @@
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utility/MappedFile.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	// IMPLEMENTATIONS OF MappedFile FUNCTIONS
+
+	/**
+	 * @param[in] path The path of the file.
+	 * @throws FileError if the file cannot be opened, read or mapped.
+	 */
+	MappedFile::MappedFile(const std::string& path)
+	{
+#ifdef _WIN32
+		std::ifstream file{ path, std::ios::binary };
+
+		if (!file)
+			throw FileError{ "Could not open the file `" + path + "`." };
+
+		std::ostringstream contents;
+		contents << file.rdbuf();
+
+		m_Contents = std::move(contents).str();
+		m_Data = m_Contents.data();
+		m_Size = m_Contents.size();
+#else
+		const int fd = ::open(path.c_str(), O_RDONLY);
+
+		if (fd < 0)
+			throw FileError{ "Could not open the file `" + path + "`." };
+
+		struct stat status {};
+
+		if (fstat(fd, &status) < 0) {
+			::close(fd);
+			throw FileError{ "Could not read the size of the file `" + path + "`." };
+		}
+
+		m_Size = (size_t)status.st_size;
+
+		// an empty file cannot be mapped, and has nothing to view anyway
+		if (m_Size) {
+			void* address = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (address == MAP_FAILED) {
+				::close(fd);
+				throw FileError{ "Could not map the file `" + path + "`." };
+			}
+
+			madvise(address, m_Size, MADV_SEQUENTIAL);
+			m_Data = static_cast<const char*>(address);
+		}
+
+		::close(fd);
+#endif
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: m_Data(std::exchange(other.m_Data, nullptr)),
+		m_Size(std::exchange(other.m_Size, 0)),
+		m_Contents(std::move(other.m_Contents))
+	{
+		// the data of a short string moves with it
+		if (!m_Contents.empty())
+			m_Data = m_Contents.data();
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Contents, other.m_Contents);
+
+		if (!m_Contents.empty())
+			m_Data = m_Contents.data();
+
+		if (!other.m_Contents.empty())
+			other.m_Data = other.m_Contents.data();
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+#ifndef _WIN32
+		if (m_Data)
+			munmap(const_cast<char*>(m_Data), m_Size);
+#endif
+	}
+
+}
@@ -0,0 +1,135 @@
+#include <bit>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "utility/Membership.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	namespace {
+
+#if defined(__AVX2__)
+		__m256i broadcast256(uint8_t value) { return _mm256_set1_epi8((char)value); }
+		__m256i broadcast256(uint16_t value) { return _mm256_set1_epi16((short)value); }
+		__m256i broadcast256(uint32_t value) { return _mm256_set1_epi32((int)value); }
+		__m256i broadcast256(uint64_t value) { return _mm256_set1_epi64x((long long)value); }
+		__m256 broadcast256(float value) { return _mm256_set1_ps(value); }
+		__m256d broadcast256(double value) { return _mm256_set1_pd(value); }
+
+		/**
+		 * @brief Compares the 32 bytes at `block` with `needle`, lane by lane.
+		 * @return A mask with a bit set for every byte of a lane equal to the needle.
+		 */
+		unsigned matchBytes(const uint8_t* block, __m256i needle) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)block), needle)); }
+		unsigned matchBytes(const uint16_t* block, __m256i needle) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i*)block), needle)); }
+		unsigned matchBytes(const uint32_t* block, __m256i needle) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)block), needle)); }
+		unsigned matchBytes(const uint64_t* block, __m256i needle) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)block), needle)); }
+		unsigned matchBytes(const float* block, __m256 needle) { return (unsigned)_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(block), needle, _CMP_EQ_OQ))); }
+		unsigned matchBytes(const double* block, __m256d needle) { return (unsigned)_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(block), needle, _CMP_EQ_OQ))); }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+		__m128i broadcast128(uint8_t value) { return _mm_set1_epi8((char)value); }
+		__m128i broadcast128(uint16_t value) { return _mm_set1_epi16((short)value); }
+		__m128i broadcast128(uint32_t value) { return _mm_set1_epi32((int)value); }
+		__m128i broadcast128(uint64_t value) { return _mm_set1_epi64x((long long)value); }
+		__m128 broadcast128(float value) { return _mm_set1_ps(value); }
+		__m128d broadcast128(double value) { return _mm_set1_pd(value); }
+
+		/**
+		 * @brief Compares the 16 bytes at `block` with `needle`, lane by lane.
+		 * @return A mask with a bit set for every byte of a lane equal to the needle.
+		 */
+		unsigned matchBytes(const uint8_t* block, __m128i needle) { return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)block), needle)); }
+		unsigned matchBytes(const uint16_t* block, __m128i needle) { return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)block), needle)); }
+		unsigned matchBytes(const uint32_t* block, __m128i needle) { return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)block), needle)); }
+		unsigned matchBytes(const float* block, __m128 needle) { return (unsigned)_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(block), needle))); }
+		unsigned matchBytes(const double* block, __m128d needle) { return (unsigned)_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(block), needle))); }
+
+		unsigned matchBytes(const uint64_t* block, __m128i needle)
+		{
+#if defined(__SSE4_1__)
+			return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)block), needle));
+#else
+			// a 64-bit lane is equal iff both of its 32-bit halves are
+			const __m128i halves = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)block), needle);
+			return (unsigned)_mm_movemask_epi8(_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1))));
+#endif
+		}
+#endif
+
+		/**
+		 * @brief Finds the first occurrence of `value`: a block of 32 bytes at a time with AVX2, then of 16 bytes with SSE2 (where available), and the rest one value at a time.
+		 */
+		template <typename T>
+		size_t find(const T* data, size_t size, T value)
+		{
+			size_t index = 0;
+
+#if defined(__AVX2__)
+			constexpr size_t lanes256 = 32 / sizeof(T);
+			const auto needle256 = broadcast256(value);
+
+			for (; index + lanes256 <= size; index += lanes256)
+				if (const unsigned mask = matchBytes(data + index, needle256))
+					return index + (size_t)std::countr_zero(mask) / sizeof(T);
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+			constexpr size_t lanes128 = 16 / sizeof(T);
+			const auto needle128 = broadcast128(value);
+
+			for (; index + lanes128 <= size; index += lanes128)
+				if (const unsigned mask = matchBytes(data + index, needle128))
+					return index + (size_t)std::countr_zero(mask) / sizeof(T);
+#endif
+
+			for (; index < size; index++)
+				if (data[index] == value)
+					return index;
+
+			return size;
+		}
+
+	}
+
+	/**
+	 * @brief Finds the first occurrence of `value` among `values`, comparing a vector register of values at a time (see `find`).
+	 * @return The index of the first value equal to `value`, or the number of values if none is.
+	 */
+	size_t findValue(std::span<const uint8_t> values, uint8_t value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+	size_t findValue(std::span<const uint16_t> values, uint16_t value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+	size_t findValue(std::span<const uint32_t> values, uint32_t value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+	size_t findValue(std::span<const uint64_t> values, uint64_t value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+	/**
+	 * @note Numbers are compared as by "==": zeros of either sign are equal, and NaNs are equal to nothing.
+	 */
+	size_t findValue(std::span<const float> values, float value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+	size_t findValue(std::span<const double> values, double value)
+	{
+		return find(values.data(), values.size(), value);
+	}
+
+}
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <chrono>
+
+#include "utility/RateLimiter.h"
+#include "utility/Logger.h"
+
+// RATE LIMITER STATE
+namespace m0st4fa {
+
+	namespace {
+
+		CallsiteLimiter s_Limiters[RateLimiter::CAPACITY];
+
+		// shared by the callsites that do not fit in the table
+		CallsiteLimiter s_OverflowLimiter;
+
+		uint64_t hashLocation(const std::source_location& location) {
+			uint64_t hash = (uint64_t)(uintptr_t)location.file_name();
+
+			hash ^= ((uint64_t)location.line() << 20) ^ (uint64_t)location.column();
+
+			// the finalizer of MurmurHash3
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdULL;
+			hash ^= hash >> 33;
+			hash *= 0xc4ceb9fe1a85ec53ULL;
+			hash ^= hash >> 33;
+
+			// zero marks an empty slot
+			return hash ? hash : 1;
+		}
+
+		int64_t getNanoseconds() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF CallsiteLimiter FUNCTIONS
+
+	/**
+	 * @brief Decides whether a message of the callsite may be logged.
+	 * @param[in] limit The sampling rate and the token bucket to apply.
+	 * @param[out] suppressedBefore If the message may be logged, the number of messages suppressed since the last logged one; 0 otherwise.
+	 * @return `true` if the message may be logged; `false` if it must be suppressed.
+	 */
+	bool CallsiteLimiter::tryAcquire(const RateLimit& limit, uint64_t& suppressedBefore)
+	{
+		suppressedBefore = 0;
+
+		// sampling
+		if (limit.everyN > 1 && count.fetch_add(1, std::memory_order_relaxed) % limit.everyN != 0) {
+			suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// token bucket
+		if (limit.ratePerSecond > 0) {
+			const int64_t interval = std::max<int64_t>(1, (int64_t)(1e9 / limit.ratePerSecond));
+			const int64_t tolerance = (int64_t)(std::max<uint32_t>(limit.burst, 1) - 1) * interval;
+			const int64_t now = getNanoseconds();
+
+			int64_t tat = theoreticalArrival.load(std::memory_order_relaxed);
+
+			while (true) {
+				const int64_t start = std::max(tat, now);
+
+				// the bucket is empty
+				if (start - now > tolerance) {
+					suppressed.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				if (theoreticalArrival.compare_exchange_weak(tat, start + interval, std::memory_order_relaxed))
+					break;
+			}
+
+		}
+
+		suppressedBefore = suppressed.exchange(0, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	// IMPLEMENTATIONS OF RateLimiter FUNCTIONS
+
+	/**
+	 * @brief Finds (or claims) the limiter of a callsite.
+	 * @param[in] location The location of the callsite.
+	 * @param[in] level The level of the messages of the callsite, reported in suppression summaries.
+	 * @return The limiter of the callsite.
+	 */
+	CallsiteLimiter& RateLimiter::get(const std::source_location& location, LOG_LEVEL level)
+	{
+		const uint64_t key = hashLocation(location);
+
+		for (size_t probe = 0; probe < CAPACITY; probe++) {
+			CallsiteLimiter& limiter = s_Limiters[(key + probe) % CAPACITY];
+			uint64_t current = limiter.key.load(std::memory_order_acquire);
+
+			if (current == key)
+				return limiter;
+
+			// claim an empty slot, and only then describe it
+			if (current == 0) {
+				if (limiter.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+					limiter.fileName.store(location.file_name(), std::memory_order_relaxed);
+					limiter.line.store(location.line(), std::memory_order_relaxed);
+					limiter.level.store((int)level, std::memory_order_relaxed);
+					limiter.described.store(true, std::memory_order_release);
+
+					return limiter;
+				}
+
+				// another thread of the same callsite claimed it first
+				if (current == key)
+					return limiter;
+			}
+
+		}
+
+		return s_OverflowLimiter;
+	}
+
+	/**
+	 * @brief Reports, and resets, the number of messages each callsite has suppressed since it last logged.
+	 * @param[in] report Called with the level, file name, line and suppressed count of every callsite that has suppressed messages.
+	 */
+	void RateLimiter::forEachSuppressed(const std::function<void(LOG_LEVEL, const char*, uint32_t, uint64_t)>& report)
+	{
+		for (CallsiteLimiter& limiter : s_Limiters) {
+			// a slot claimed but not yet described keeps its count until the next report
+			if (!limiter.described.load(std::memory_order_acquire))
+				continue;
+
+			const uint64_t suppressed = limiter.suppressed.exchange(0, std::memory_order_relaxed);
+
+			if (suppressed)
+				report((LOG_LEVEL)limiter.level.load(std::memory_order_relaxed), limiter.fileName.load(std::memory_order_relaxed), limiter.line.load(std::memory_order_relaxed), suppressed);
+		}
+
+		if (const uint64_t suppressed = s_OverflowLimiter.suppressed.exchange(0, std::memory_order_relaxed))
+			report(LOG_LEVEL::LL_WARRNING, "<other callsites>", 0, suppressed);
+	}
+
+}
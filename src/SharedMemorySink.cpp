@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utility/SharedMemorySink.h"
+
+// FRAMES
+namespace m0st4fa {
+
+	namespace {
+
+		enum class FRAME_KIND : uint8_t {
+			FK_RECORD = 1,
+			FK_PADDING,
+		};
+
+		/**
+		 * @brief The header of a frame, followed by the message and the location. A padding frame only uses the first 8 bytes.
+		 */
+		struct FrameHeader {
+			uint32_t size;		// including the header and the alignment
+			FRAME_KIND kind;
+			uint8_t level;
+			uint16_t reserved;
+			uint32_t messageSize;
+			uint32_t locationSize;
+			int64_t timestamp;
+		};
+
+		constexpr size_t FRAME_ALIGNMENT = 8;
+		constexpr size_t PADDING_FRAME_SIZE = 8;
+
+		static_assert(sizeof(FrameHeader) % FRAME_ALIGNMENT == 0);
+		static_assert(sizeof(SharedLogRing::Header) % FRAME_ALIGNMENT == 0);
+
+		constexpr uint64_t alignFrame(uint64_t size) {
+			return (size + FRAME_ALIGNMENT - 1) & ~(uint64_t)(FRAME_ALIGNMENT - 1);
+		}
+
+		std::string getObjectName(const std::string& name) {
+			return name.starts_with('/') ? name : '/' + name;
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF SharedLogRing FUNCTIONS
+
+	/**
+	 * @brief Maps a ring, creating and initializing it if `create` is set and it does not exist.
+	 * @throws LogSinkError if the shared memory object cannot be opened or mapped, or does not hold a ring.
+	 */
+	SharedLogRing::SharedLogRing(const std::string& name, size_t capacity, bool create)
+		: m_Name(getObjectName(name))
+	{
+#ifdef _WIN32
+		throw LogSinkError{ "Shared-memory log rings are not supported on Windows." };
+#else
+		const int fd = shm_open(m_Name.c_str(), O_RDWR | (create ? O_CREAT : 0), 0600);
+
+		if (fd < 0)
+			throw LogSinkError{ "Could not open the shared memory object `" + m_Name + "`." };
+
+		struct stat status {};
+		bool initialize = false;
+
+		if (fstat(fd, &status) < 0) {
+			::close(fd);
+			throw LogSinkError{ "Could not open the shared memory object `" + m_Name + "`." };
+		}
+
+		m_MappedSize = (size_t)status.st_size;
+
+		if (create && m_MappedSize == 0) {
+			m_MappedSize = sizeof(Header) + std::bit_ceil(std::max(capacity, MIN_CAPACITY));
+			initialize = true;
+
+			if (ftruncate(fd, (off_t)m_MappedSize) < 0) {
+				::close(fd);
+				throw LogSinkError{ "Could not size the shared memory object `" + m_Name + "`." };
+			}
+		}
+
+		void* address = m_MappedSize >= sizeof(Header) ? mmap(nullptr, m_MappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+		::close(fd);
+
+		if (address == MAP_FAILED)
+			throw LogSinkError{ "Could not map the shared memory object `" + m_Name + "`." };
+
+		// the memory of a new object is zeroed, which is a valid state of the atomics
+		m_Header = static_cast<Header*>(address);
+		m_Data = static_cast<std::byte*>(address) + sizeof(Header);
+
+		if (initialize) {
+			m_Header->version = VERSION;
+			m_Header->capacity = m_MappedSize - sizeof(Header);
+			m_Header->magic.store(MAGIC, std::memory_order_release);
+		}
+
+		const uint64_t dataSize = m_Header->capacity;
+
+		if (m_Header->magic.load(std::memory_order_acquire) != MAGIC || m_Header->version != VERSION || !std::has_single_bit(dataSize) || dataSize > m_MappedSize - sizeof(Header)) {
+			munmap(address, m_MappedSize);
+			m_Header = nullptr;
+			throw LogSinkError{ "The shared memory object `" + m_Name + "` does not hold a log ring (or is still being created)." };
+		}
+
+		m_Consumed = m_Header->readPosition.load(std::memory_order_acquire);
+#endif
+	}
+
+	/**
+	 * @brief Opens a ring as its producer, creating it if it does not exist.
+	 * @param[in] name The name of the shared memory object (a leading `/` is added if missing).
+	 * @param[in] capacity The number of data bytes, rounded up to a power of two; ignored if the ring already exists.
+	 * @throws LogSinkError if the ring cannot be opened or created.
+	 */
+	SharedLogRing SharedLogRing::create(const std::string& name, size_t capacity)
+	{
+		return SharedLogRing{ name, capacity, true };
+	}
+
+	/**
+	 * @brief Opens an existing ring as its consumer.
+	 * @param[in] name The name of the shared memory object (a leading `/` is added if missing).
+	 * @throws LogSinkError if the ring does not exist or cannot be opened.
+	 */
+	SharedLogRing SharedLogRing::open(const std::string& name)
+	{
+		return SharedLogRing{ name, 0, false };
+	}
+
+	/**
+	 * @brief Removes a ring from the system. Processes that have it open keep using it.
+	 * @param[in] name The name of the shared memory object (a leading `/` is added if missing).
+	 * @return `true` if the ring was removed; `false` otherwise.
+	 */
+	bool SharedLogRing::remove(const std::string& name)
+	{
+#ifdef _WIN32
+		return false;
+#else
+		return shm_unlink(getObjectName(name).c_str()) == 0;
+#endif
+	}
+
+	SharedLogRing::SharedLogRing(SharedLogRing&& other) noexcept
+		: m_Name(std::move(other.m_Name)),
+		m_Header(std::exchange(other.m_Header, nullptr)),
+		m_Data(std::exchange(other.m_Data, nullptr)),
+		m_MappedSize(std::exchange(other.m_MappedSize, 0)),
+		m_Consumed(other.m_Consumed)
+	{
+	}
+
+	SharedLogRing& SharedLogRing::operator=(SharedLogRing&& other) noexcept
+	{
+		std::swap(m_Name, other.m_Name);
+		std::swap(m_Header, other.m_Header);
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_MappedSize, other.m_MappedSize);
+		std::swap(m_Consumed, other.m_Consumed);
+
+		return *this;
+	}
+
+	SharedLogRing::~SharedLogRing()
+	{
+#ifndef _WIN32
+		if (m_Header)
+			munmap(m_Header, m_MappedSize);
+#endif
+	}
+
+	/**
+	 * @brief Appends a record, unless the ring is full.
+	 * @details A record is limited to a quarter of the ring: longer locations and messages are truncated.
+	 * @param[in] record The record.
+	 * @param[in] timestamp The time of the record, in nanoseconds since the epoch of `std::chrono::system_clock`.
+	 * @return `true` if the record was written; `false` if it was dropped.
+	 * @attention Only one thread of one process may write to a ring at a time.
+	 */
+	bool SharedLogRing::tryWrite(const LogRecord& record, int64_t timestamp)
+	{
+		const uint64_t capacity = m_Header->capacity;
+		const size_t maxPayloadSize = capacity / 4 - sizeof(FrameHeader);
+		const size_t locationSize = std::min(record.location.size(), maxPayloadSize / 2);
+		const size_t messageSize = std::min(record.message.size(), maxPayloadSize - locationSize);
+		const uint64_t frameSize = alignFrame(sizeof(FrameHeader) + messageSize + locationSize);
+
+		const uint64_t write = m_Header->writePosition.load(std::memory_order_relaxed);
+		const uint64_t read = m_Header->readPosition.load(std::memory_order_acquire);
+		const uint64_t offset = write & (capacity - 1);
+
+		// a frame never wraps around; the end of the data is skipped instead
+		const uint64_t padding = capacity - offset < frameSize ? capacity - offset : 0;
+
+		if (write + padding + frameSize - read > capacity) {
+			m_Header->dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		if (padding) {
+			FrameHeader header{};
+			header.size = (uint32_t)padding;
+			header.kind = FRAME_KIND::FK_PADDING;
+
+			std::memcpy(m_Data + offset, &header, PADDING_FRAME_SIZE);
+		}
+
+		std::byte* frame = m_Data + ((write + padding) & (capacity - 1));
+		const FrameHeader header{ (uint32_t)frameSize, FRAME_KIND::FK_RECORD, (uint8_t)record.level, 0, (uint32_t)messageSize, (uint32_t)locationSize, timestamp };
+
+		std::memcpy(frame, &header, sizeof(header));
+		std::memcpy(frame + sizeof(header), record.message.data(), messageSize);
+		std::memcpy(frame + sizeof(header) + messageSize, record.location.data(), locationSize);
+
+		m_Header->writePosition.store(write + padding + frameSize, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief Reads the records published so far, without releasing them to the producer (see `commit`).
+	 * @param[out] entries The vector the records are appended to.
+	 * @param[in] maxCount The maximum number of records to read.
+	 * @return The number of records read. If a malformed frame follows them, the records before it are returned, and the next call throws.
+	 * @throws LogSinkError if the ring holds a malformed frame at the read position; everything published so far is then skipped.
+	 */
+	size_t SharedLogRing::read(std::vector<SharedLogEntry>& entries, size_t maxCount)
+	{
+		const uint64_t capacity = m_Header->capacity;
+		const uint64_t write = m_Header->writePosition.load(std::memory_order_acquire);
+		size_t count = 0;
+
+		while (m_Consumed < write && count < maxCount) {
+			const uint64_t offset = m_Consumed & (capacity - 1);
+			FrameHeader header{};
+
+			std::memcpy(&header, m_Data + offset, PADDING_FRAME_SIZE);
+
+			const bool validSize = header.size >= PADDING_FRAME_SIZE && header.size % FRAME_ALIGNMENT == 0 && header.size <= capacity - offset && header.size <= write - m_Consumed;
+
+			if (validSize && header.kind == FRAME_KIND::FK_PADDING) {
+				m_Consumed += header.size;
+				continue;
+			}
+
+			if (validSize && header.kind == FRAME_KIND::FK_RECORD && header.size >= sizeof(FrameHeader))
+				std::memcpy(&header, m_Data + offset, sizeof(header));
+
+			if (!validSize || header.kind != FRAME_KIND::FK_RECORD || header.size < sizeof(FrameHeader) || (uint64_t)header.messageSize + header.locationSize > header.size - sizeof(FrameHeader) || header.level >= (uint8_t)LOG_LEVEL::LL_LOG_LEVEL_COUNT) {
+				// the records before the malformed frame are returned first
+				if (count)
+					return count;
+
+				m_Consumed = write;
+				throw LogSinkError{ "The log ring `" + m_Name + "` holds a malformed frame." };
+			}
+
+			const char* payload = reinterpret_cast<const char*>(m_Data + offset + sizeof(header));
+			SharedLogEntry& entry = entries.emplace_back();
+
+			entry.record.level = (LOG_LEVEL)header.level;
+			entry.record.message.assign(payload, header.messageSize);
+			entry.record.location.assign(payload + header.messageSize, header.locationSize);
+			entry.timestamp = header.timestamp;
+
+			m_Consumed += header.size;
+			count++;
+		}
+
+		return count;
+	}
+
+	/**
+	 * @brief Releases the records read so far to the producer. Until then, a consumer that restarts reads them again.
+	 */
+	void SharedLogRing::commit()
+	{
+		m_Header->readPosition.store(m_Consumed, std::memory_order_release);
+	}
+
+	// IMPLEMENTATIONS OF SharedMemorySink FUNCTIONS
+
+	/**
+	 * @throws LogSinkError if the ring cannot be opened or created.
+	 */
+	SharedMemorySink::SharedMemorySink(const SharedMemorySinkOptions& options)
+		: m_Ring(SharedLogRing::create(options.name, options.capacity))
+	{
+	}
+
+	void SharedMemorySink::write(std::span<const LogRecord> records)
+	{
+		const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		std::lock_guard lock{ m_Mutex };
+
+		for (const LogRecord& record : records)
+			m_Ring.tryWrite(record, timestamp);
+	}
+
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+
+#include "utility/TableFormat.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	namespace {
+
+		bool needsQuotes(std::string_view cell) {
+			return cell.find_first_of(",\"\r\n") != std::string_view::npos;
+		}
+
+		template <typename Builder>
+		void appendEscapedTo(Builder& builder, std::string_view cell, TABLE_STYLE style)
+		{
+			switch (style) {
+				case TABLE_STYLE::TS_CSV:
+					if (!needsQuotes(cell)) {
+						builder.append(cell);
+						break;
+					}
+
+					builder.append('"');
+
+					for (const char c : cell)
+						c == '"' ? builder.append("\"\"") : builder.append(c);
+
+					builder.append('"');
+					break;
+				case TABLE_STYLE::TS_TSV:
+					for (const char c : cell)
+						switch (c) {
+							case '\t':
+								builder.append("\\t");
+								break;
+							case '\n':
+								builder.append("\\n");
+								break;
+							case '\r':
+								builder.append("\\r");
+								break;
+							case '\\':
+								builder.append("\\\\");
+								break;
+							default:
+								builder.append(c);
+						}
+					break;
+				case TABLE_STYLE::TS_MARKDOWN:
+					for (const char c : cell)
+						c == '|' ? builder.append("\\|") : builder.append(c);
+					break;
+				default:
+					builder.append(cell);
+			}
+		}
+
+	}
+
+	// IMPLEMENTATIONS OF TABLE FUNCTIONS
+
+	/**
+	 * @brief Computes the size of a cell once escaped for a table style.
+	 * @param[in] cell The text of the cell.
+	 * @param[in] style The table style.
+	 * @return The size of the escaped text.
+	 */
+	size_t getEscapedSize(std::string_view cell, TABLE_STYLE style)
+	{
+		switch (style) {
+			case TABLE_STYLE::TS_CSV:
+				return needsQuotes(cell) ? cell.size() + 2 + (size_t)std::ranges::count(cell, '"') : cell.size();
+			case TABLE_STYLE::TS_TSV:
+				return cell.size() + (size_t)std::ranges::count_if(cell, [](char c) { return c == '\t' || c == '\n' || c == '\r' || c == '\\'; });
+			case TABLE_STYLE::TS_MARKDOWN:
+				return cell.size() + (size_t)std::ranges::count(cell, '|');
+			default:
+				return cell.size();
+		}
+	}
+
+	/**
+	 * @brief Appends a cell, escaped for a table style: quoted for CSV, backslash-escaped for TSV and with escaped pipes for Markdown.
+	 * @param[out] builder The builder to append to.
+	 * @param[in] cell The text of the cell.
+	 * @param[in] style The table style.
+	 */
+	void appendEscaped(StringBuilder& builder, std::string_view cell, TABLE_STYLE style)
+	{
+		appendEscapedTo(builder, cell, style);
+	}
+
+	void appendEscaped(PmrStringBuilder& builder, std::string_view cell, TABLE_STYLE style)
+	{
+		appendEscapedTo(builder, cell, style);
+	}
+
+	/**
+	 * @brief Renders a table of strings (see `renderTable`). Rows may have different sizes: missing cells are empty.
+	 * @param[in] rows The rows of the table, the header row (if any) first.
+	 * @param[in] style The output format.
+	 * @return The rendered table.
+	 */
+	std::string renderTable(const std::vector<std::vector<std::string>>& rows, TABLE_STYLE style)
+	{
+		size_t columnCount = 0;
+
+		for (const auto& row : rows)
+			columnCount = std::max(columnCount, row.size());
+
+		return renderTable(rows.size(), columnCount, [&rows](size_t row, size_t column) {
+			return column < rows[row].size() ? std::string_view{ rows[row][column] } : std::string_view{};
+			}, style);
+	}
+
+}
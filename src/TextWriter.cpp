@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "utility/TextWriter.h"
+
+// FUNCTIONS
+namespace m0st4fa::utility {
+
+	// IMPLEMENTATIONS OF FdWriter FUNCTIONS
+
+	/**
+	 * @param[in] fd The file descriptor to write to. It is not closed by the writer.
+	 * @param[in] bufferSize The size of the buffer (at least one character).
+	 */
+	FdWriter::FdWriter(int fd, size_t bufferSize)
+		: m_Fd(fd), m_Buffer(std::make_unique<char[]>(std::max<size_t>(bufferSize, 1))), m_Capacity(std::max<size_t>(bufferSize, 1))
+	{
+	}
+
+	/**
+	 * @brief Writes out the buffer. Errors are ignored; call `flush` first to detect them.
+	 */
+	FdWriter::~FdWriter()
+	{
+		try {
+			flush();
+		}
+		catch (const WriteError&) {
+		}
+	}
+
+	/**
+	 * @throws WriteError if the file descriptor cannot be written to.
+	 */
+	void FdWriter::writeOut(const char* data, size_t size)
+	{
+		while (size) {
+#ifdef _WIN32
+			const int written = _write(m_Fd, data, (unsigned int)std::min<size_t>(size, 1u << 30));
+#else
+			const ssize_t written = ::write(m_Fd, data, size);
+#endif
+
+			if (written < 0)
+				throw WriteError{ std::format("Could not write to the file descriptor {}.", m_Fd) };
+
+			data += written;
+			size -= (size_t)written;
+		}
+	}
+
+	/**
+	 * @brief Appends text, writing out the buffer whenever it fills up.
+	 * @throws WriteError if the file descriptor cannot be written to.
+	 */
+	FdWriter& FdWriter::append(std::string_view text)
+	{
+		if (text.size() > m_Capacity - m_Size) {
+			flush();
+
+			if (text.size() >= m_Capacity) {
+				writeOut(text.data(), text.size());
+				return *this;
+			}
+		}
+
+		std::memcpy(m_Buffer.get() + m_Size, text.data(), text.size());
+		m_Size += text.size();
+
+		return *this;
+	}
+
+	/**
+	 * @brief Writes out the buffer.
+	 * @throws WriteError if the file descriptor cannot be written to.
+	 */
+	void FdWriter::flush()
+	{
+		const size_t size = std::exchange(m_Size, 0);
+		writeOut(m_Buffer.get(), size);
+	}
+
+}
@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "utility/Trace.h"
+
+// TRACER STATE
+namespace m0st4fa {
+
+	namespace {
+
+		/**
+		 * @brief A fixed-size block of spans. Only the owning thread appends to it, publishing each span through `size`.
+		 */
+		struct TraceChunk {
+			static constexpr size_t CAPACITY = 4096;
+
+			TraceEvent events[CAPACITY];
+			std::atomic<size_t> size{ 0 };
+		};
+
+		struct ThreadTraceBuffer {
+			std::mutex mutex{};	// guards `chunks` against exports; never taken to record a span
+			std::vector<std::unique_ptr<TraceChunk>> chunks{};
+			TraceChunk* current = nullptr;
+			std::set<std::string, std::less<>> names{};	// a set never moves its elements
+			size_t threadIndex = 0;
+
+			ThreadTraceBuffer() {
+				chunks.push_back(std::make_unique<TraceChunk>());
+				current = chunks.back().get();
+			}
+
+			TraceChunk* addChunk() {
+				std::lock_guard lock{ mutex };
+
+				chunks.push_back(std::make_unique<TraceChunk>());
+				return current = chunks.back().get();
+			}
+		};
+
+		struct TracerState {
+			std::mutex mutex{};
+			std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers{};	// including those of exited threads
+			size_t threadCount = 0;
+		};
+
+		TracerState& getState() {
+			static TracerState state;
+			return state;
+		}
+
+		/**
+		 * @brief Registers the buffer of the current thread. The buffer outlives the thread, so that its spans can still be exported.
+		 */
+		struct ThreadTraceBufferHandle {
+			std::shared_ptr<ThreadTraceBuffer> buffer = std::make_shared<ThreadTraceBuffer>();
+
+			ThreadTraceBufferHandle() {
+				TracerState& state = getState();
+				std::lock_guard lock{ state.mutex };
+
+				buffer->threadIndex = state.threadCount++;
+				state.buffers.push_back(buffer);
+			}
+		};
+
+		ThreadTraceBuffer& getThreadBuffer() {
+			thread_local ThreadTraceBufferHandle handle;
+			return *handle.buffer;
+		}
+
+		struct ClockCalibration {
+			uint64_t ticks = TraceClock::now();
+			std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		};
+
+		// the reference point is taken during static initialization, so that the calibration interval is usually long by the time it is needed
+		const ClockCalibration& getCalibration() {
+			static const ClockCalibration calibration;
+			return calibration;
+		}
+
+		[[maybe_unused]] const ClockCalibration& s_Calibration = getCalibration();
+
+		struct ExportedEvent {
+			TraceEvent event;
+			size_t threadIndex;
+		};
+
+		void appendEscaped(std::string& out, std::string_view text) {
+			for (const char c : text)
+				switch (c) {
+					case '"':
+						out += "\\\"";
+						break;
+					case '\\':
+						out += "\\\\";
+						break;
+					default:
+						if ((unsigned char)c < 0x20)
+							out += std::format("\\u{:04x}", (unsigned)c);
+						else
+							out += c;
+				}
+		}
+
+		int getProcessId() {
+#ifdef _WIN32
+			return _getpid();
+#else
+			return (int)getpid();
+#endif
+		}
+
+	}
+
+}
+
+// FUNCTIONS
+namespace m0st4fa {
+
+	// IMPLEMENTATIONS OF TraceClock FUNCTIONS
+
+	/**
+	 * @brief Calibrates the clock against `std::chrono::steady_clock`.
+	 * @details The calibration interval starts at program startup; if less than 10ms have passed, the call waits for the rest. Once the interval exceeds a second, the result is cached.
+	 * @return The number of ticks per nanosecond.
+	 */
+	double TraceClock::getTicksPerNanosecond()
+	{
+#ifdef UTILITY_TRACE_CLOCK_TSC
+		static std::atomic<double> s_Cached{ 0.0 };
+
+		if (const double cached = s_Cached.load(std::memory_order_relaxed))
+			return cached;
+
+		const ClockCalibration& calibration = getCalibration();
+
+		if (std::chrono::steady_clock::now() - calibration.time < std::chrono::milliseconds{ 10 })
+			std::this_thread::sleep_until(calibration.time + std::chrono::milliseconds{ 10 });
+
+		const uint64_t ticks = now();
+		const auto elapsed = std::chrono::steady_clock::now() - calibration.time;
+		const double ratio = (double)(ticks - calibration.ticks) / (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+		if (elapsed >= std::chrono::seconds{ 1 })
+			s_Cached.store(ratio, std::memory_order_relaxed);
+
+		return ratio;
+#else
+		return 1.0;
+#endif
+	}
+
+	// IMPLEMENTATIONS OF Tracer FUNCTIONS
+
+	/**
+	 * @brief Appends a completed span to the buffer of the current thread.
+	 * @param[in] name The name of the span.
+	 * @param[in] begin The tick count at which the span began.
+	 * @param[in] end The tick count at which the span ended.
+	 */
+	void Tracer::record(const char* name, uint64_t begin, uint64_t end)
+	{
+		ThreadTraceBuffer& buffer = getThreadBuffer();
+		TraceChunk* chunk = buffer.current;
+		size_t size = chunk->size.load(std::memory_order_relaxed);
+
+		if (size == TraceChunk::CAPACITY) {
+			chunk = buffer.addChunk();
+			size = 0;
+		}
+
+		chunk->events[size] = { name, begin, end };
+		chunk->size.store(size + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Copies a span name into storage owned by the current thread, once per distinct name.
+	 * @param[in] name The name.
+	 * @return A copy of the name that lives as long as the program.
+	 */
+	const char* Tracer::intern(std::string_view name)
+	{
+		ThreadTraceBuffer& buffer = getThreadBuffer();
+		auto it = buffer.names.find(name);
+
+		if (it == buffer.names.end())
+			it = buffer.names.emplace(name).first;
+
+		return it->c_str();
+	}
+
+	/**
+	 * @brief Writes the spans of every thread as a Chrome trace event JSON document.
+	 * @details Every span becomes a complete ("X") event, with its timestamp in microseconds since the earliest span and the index of its thread as its thread ID.
+	 * @param[out] out The stream to write to.
+	 * @return The number of spans written.
+	 */
+	size_t Tracer::exportChromeTrace(std::ostream& out)
+	{
+		TracerState& state = getState();
+		std::vector<ExportedEvent> events;
+
+		{
+			std::lock_guard lock{ state.mutex };
+
+			for (const auto& buffer : state.buffers) {
+				std::lock_guard bufferLock{ buffer->mutex };
+
+				for (const auto& chunk : buffer->chunks) {
+					const size_t size = chunk->size.load(std::memory_order_acquire);
+
+					for (size_t i = 0; i < size; i++)
+						events.push_back({ chunk->events[i], buffer->threadIndex });
+				}
+			}
+		}
+
+		std::stable_sort(events.begin(), events.end(), [](const ExportedEvent& lhs, const ExportedEvent& rhs) {
+			return lhs.event.begin < rhs.event.begin;
+			});
+
+		const double ticksPerMicrosecond = TraceClock::getTicksPerNanosecond() * 1000.0;
+		const uint64_t origin = events.empty() ? 0 : events.front().event.begin;
+		const int pid = getProcessId();
+
+		std::string text = "{\"traceEvents\":[";
+
+		for (size_t i = 0; i < events.size(); i++) {
+			const auto& [event, threadIndex] = events[i];
+
+			text += i ? ",\n{\"name\":\"" : "\n{\"name\":\"";
+			appendEscaped(text, event.name);
+			text += std::format("\",\"cat\":\"utility\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}",
+				(double)(event.begin - origin) / ticksPerMicrosecond, (double)(event.end - event.begin) / ticksPerMicrosecond, pid, threadIndex);
+		}
+
+		text += "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+		out.write(text.data(), (std::streamsize)text.size());
+		out.flush();
+
+		return events.size();
+	}
+
+	/**
+	 * @brief Writes the spans of every thread to a Chrome trace event JSON file.
+	 * @param[in] path The path of the file, which is overwritten.
+	 * @return `true` if the file was written; `false` otherwise.
+	 */
+	bool Tracer::exportChromeTrace(const std::string& path)
+	{
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+
+		if (!file)
+			return false;
+
+		exportChromeTrace(file);
+
+		return (bool)file;
+	}
+
+	/**
+	 * @brief Forgets the spans recorded by every thread.
+	 * @attention Must not be called while other threads are recording.
+	 */
+	void Tracer::clear()
+	{
+		TracerState& state = getState();
+		std::lock_guard lock{ state.mutex };
+
+		for (const auto& buffer : state.buffers) {
+			std::lock_guard bufferLock{ buffer->mutex };
+
+			buffer->chunks.resize(1);
+			buffer->current = buffer->chunks.front().get();
+			buffer->current->size.store(0, std::memory_order_relaxed);
+		}
+	}
+
+}
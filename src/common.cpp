@@ -3,6 +3,7 @@
 #include <type_traits>
 #include <concepts>
 #include <format>
+#include <algorithm>
 
 #include "utility/common.h"
 #include "utility/Logger.h"
@@ -30,60 +31,54 @@ namespace m0st4fa::utility {
 	// INTEGER
 
 	/**
-	 * @brief Converts a string to an integer.
-	 * @attention Right now it converts only to positive (unsigned) integers.
+	 * @brief Converts the first (unsigned, decimal) integer within a string to an integer, without throwing, logging or allocating.
+	 * @details Characters before the first digit are skipped; the integer is parsed by `parseInteger`, and characters after it are ignored.
 	 * @param str The string to be converted to an integer.
-	 * @todo Implement `atBeginning` bool parameter. This should allow the function to parse and convert integers within a string, not just at its beginning.
-	 * @todo Implement conversion of negative integers.
-	 * @return An integer representation of the string.
+	 * @return The integer; or the error (`PE_NO_DIGITS` or `PE_OVERFLOW`) and the offset of the integer (the size of `str` if there is none).
 	 */
-	size_t toInteger(const std::string& str) {
+	Expected<size_t, ConversionFailure> tryToInteger(std::string_view str) {
 		// find the first integer
-		auto itr = std::find_if(str.begin(), str.end(), isalnum);
+		const size_t first = std::min(str.find_first_of("0123456789"), str.size());
+		const ParseResult<size_t> result = parseInteger<size_t>(str.substr(first));
 
-		if (itr == str.end()) {
-			Logger logger;
+		if (!result)
+			return Unexpected{ ConversionFailure{ result.error, first } };
 
-			std::string msg = std::format("Could not convert the string `{}` into integer (Could not even extract an integer from it.)", str);
-
-			logger.log(LoggerInfo::LL_ERROR, msg);
-			throw ConversionError{msg};
-		}
+		return result.value;
+	}
 
-		size_t res = 0;
+	/**
+	 * @brief Converts the first (unsigned, decimal) integer within a string to an integer (see `tryToInteger`, which this wraps).
+	 * @param str The string to be converted to an integer.
+	 * @throws ConversionError if `str` contains no digit or if the integer does not fit into a `size_t`. The error is logged first.
+	 * @return An integer representation of the string.
+	 */
+	size_t toInteger(const std::string& str) {
+		const Expected<size_t, ConversionFailure> result = tryToInteger(str);
 
-		for (; itr < str.end(); itr++) {
-			const char currChar = *itr;
+		if (!result) {
+			Logger logger;
 
-			// if the current character is not numeric
-			if (not isalnum(currChar))
-				break;
+			std::string msg = result.error().error == PARSE_ERROR::PE_OVERFLOW ?
+				std::format("Could not convert the string `{}` into integer (The integer at offset {} is too large.)", str, result.error().offset) :
+				std::format("Could not convert the string `{}` into integer (Could not even extract an integer from it.)", str);
 
-			size_t numVal = ((size_t)currChar - '0');
-			res += numVal;
-			res *= 10;
+			// malformed input tends to come in floods; keep the log readable
+			logger.log(LoggerInfo::LL_ERROR, msg, RateLimit{ .ratePerSecond = 10, .burst = 10 });
+			throw ConversionError{msg};
 		}
 
-		return res / 10;
+		return *result;
 	}
 
 	/**
-	 * @brief Raise `base` to the power of `p` and return the result.
-	 * @todo Right now it is brute force...and it is very slow. Implement a more sophisticated algorithm.
+	 * @brief Raise `base` to the power of `p` and return the result (see the templated `pow`, which this calls).
 	 * @param base The base of the exponentiation.
 	 * @param p The power of the exponentiation.
-	 * @return `base` raised to the power of `p`.
+	 * @return `base` raised to the power of `p`, modulo 2^64 (see `checkedPow` to detect overflow).
 	 */
 	size_t pow(size_t base, size_t p) {
-			if (p == 0)
-				return 1;
-
-			size_t res = base;
-
-			for (size_t i = 1; p > i; i++)
-				res *= res;
-
-			return res;
+			return pow<size_t>(base, p);
 		}
 
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "utility/common.h"
+#include "utility/BulkParse.h"
+#include "testIncludes.h"
+
+int integerTests() {
+
+	using m0st4fa::utility::parseInteger;
+
+	// signed and unsigned integers of any width, in bases 2, 8, 10 and 16
+	std::cout << fmt::format("Parsed: {}, {}, {}, {}\n", parseInteger<int>("-12345").value, parseInteger<uint8_t>("11111111", 2).value, parseInteger<int16_t>("-777", 8).value, parseInteger<uint64_t>("DeadBeef", 16).value);
+
+	// the number of characters taken by the integer
+	const auto result = parseInteger<long long>("1234567890123456789, 42");
+	std::cout << fmt::format("Parsed {} from {} characters\n", result.value, result.consumed);
+
+	// errors
+	std::cout << fmt::format("Overflow: {}, no digits: {}, invalid base: {}\n",
+		parseInteger<int8_t>("128").error == m0st4fa::utility::PARSE_ERROR::PE_OVERFLOW,
+		parseInteger<unsigned>("-1").error == m0st4fa::utility::PARSE_ERROR::PE_NO_DIGITS,
+		parseInteger<int>("1", 3).error == m0st4fa::utility::PARSE_ERROR::PE_INVALID_BASE);
+
+	std::cout << fmt::format("toInteger: {}\n", m0st4fa::utility::toInteger("state 42"));
+
+	// failures as values: no exception, no logging and no allocation
+	for (const std::string_view text : { "42", "4x2", "99999999999999999999" })
+		if (const auto parsed = m0st4fa::utility::tryParseInteger<uint32_t>(text))
+			std::cout << fmt::format("tryParseInteger(\"{}\"): {}\n", text, *parsed);
+		else
+			std::cout << fmt::format("tryParseInteger(\"{}\"): error {} at offset {}\n", text, (int)parsed.error().error, parsed.error().offset);
+
+	std::cout << fmt::format("tryToInteger: {}\n", m0st4fa::utility::tryToInteger("no digits").has_value());
+
+	// `value` throws where the `Expected` holds an error
+	try {
+		m0st4fa::utility::tryToInteger("no digits").value();
+	}
+	catch (const m0st4fa::utility::BadExpectedAccess<m0st4fa::utility::ConversionFailure>& e) {
+		std::cout << fmt::format("value() threw for error {}\n", (int)e.error().error);
+	}
+
+	// exponentiation by squaring, evaluated at compile time where possible
+	constexpr uint64_t billion = m0st4fa::utility::pow<uint64_t>(10, 9);
+	std::cout << fmt::format("pow: {}, {}, checked: {}, saturating: {}\n", billion, m0st4fa::utility::pow(-3, 3), m0st4fa::utility::checkedPow<int>(2, 31).has_value(), m0st4fa::utility::saturatingPow<int8_t>(-2, 9));
+	std::cout << fmt::format("powMod: {}, ilog2: {}, ilog10: {}, isqrt: {}\n", m0st4fa::utility::powMod(3, 1'000'000, 1'000'000'007), m0st4fa::utility::ilog2(1000u), m0st4fa::utility::ilog10(1000u), m0st4fa::utility::isqrt(1000u));
+
+	// delimited integers in bulk; malformed fields are reported by offset instead of thrown
+	std::vector<m0st4fa::utility::FieldError> errors;
+	const std::vector<int> values = m0st4fa::utility::parseIntegers<int>("1, 2,,x, 3 4,-5\n", errors);
+
+	std::cout << fmt::format("Bulk parsed: {}\n", m0st4fa::utility::toString(values));
+
+	for (const m0st4fa::utility::FieldError& error : errors)
+		std::cout << fmt::format("Field {} at offset {} could not be parsed (error {})\n", error.index, error.offset, (int)error.error);
+
+	return 0;
+}
@@ -1,4 +1,7 @@
 #include <vector>
+#include <string>
+#include <set>
+#include <bitset>
 
 #include "fmt/ranges.h"
 #include "utility/common.h"
@@ -18,11 +21,79 @@ int iterableTests() {
 	std::vector<size_t> it1{ 1, 2, 3, 4, 5, 6 };
 	std::vector<size_t> it2{ 1, 2, 4, 3, 6, 5 };
 	std::vector<size_t> it3{ 1, 5, 6, 7 };
+	std::vector<size_t> it4{ 1, 1, 2 };
+	std::vector<size_t> it5{ 1, 2, 2 };
+	std::vector<size_t> it6{ 2, 1, 1 };
 
 
 	// Write more tests for more iterables
 	std::cout << fmt::format("{} {} {}\n", toString(it1), comp(it1, it2), toString(it2));
 	std::cout << fmt::format("{} {} {}\n", toString(it1), comp(it1, it3), toString(it3));
 
+	// duplicates must occur as many times in both
+	std::cout << fmt::format("{} {} {}\n", toString(it4), comp(it4, it5), toString(it5));
+	std::cout << fmt::format("{} {} {}\n", toString(it4), comp(it4, it6), toString(it6));
+
+	// hashable, ordered and floating-point elements take other strategies
+	std::vector<std::string> words1{ "a", "b", "b" };
+	std::vector<std::string> words2{ "b", "a", "b" };
+	std::vector<std::string> words3{ "a", "a", "b" };
+	std::vector<double> reals1{ 0.5, -0.0, 2.5 };
+	std::vector<double> reals2{ 2.5, 0.0, 0.5 };
+
+	std::cout << fmt::format("{} {} {}\n", words1, areEqualAsMultisets(words1, words2) ? "==" : "!=", words2);
+	std::cout << fmt::format("{} {} {}\n", words1, areEqualAsMultisets(words1, words3) ? "==" : "!=", words3);
+	std::cout << fmt::format("{} {} {}\n", reals1, areEqualAsMultisets(reals1, reals2) ? "==" : "!=", reals2);
+
+	// membership: searched by `contains`, by binary search, a vector register at a time, and linearly
+	auto in = [](bool found) { return found ? "in" : "not in"; };
+
+	std::set<size_t> states{ 2, 4, 8 };
+	std::vector<int> numbers{ -5, 3, 7, 9, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67 };
+	std::vector<int> sorted{ 1, 3, 5, 7 };
+
+	std::cout << fmt::format("4 {} {}\n", in(isIn(4, states)), states);
+	std::cout << fmt::format("67 {} {}\n", in(isIn(67, numbers)), numbers);
+	std::cout << fmt::format("-5 {} {}\n", in(isIn(-5L, numbers)), numbers);
+	std::cout << fmt::format("4 {} {}\n", in(isIn(4, asSorted(sorted))), sorted);
+	std::cout << fmt::format("\"b\" {} {}\n", in(isIn(std::string{ "b" }, words3)), words3);
+
+	std::vector<int> needles{ 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116 };
+	std::cout << fmt::format("any of {} {} {}\n", needles, in(isInAny(needles, numbers)), numbers);
+	needles.push_back(61);
+	std::cout << fmt::format("any of {} {} {}\n", needles, in(isInAny(needles, numbers)), numbers);
+
+	// bulk insertion: merged into sets and sorted vectors, word by word into bitsets
+	std::set<size_t> closure{ 1, 3, 5 };
+	std::vector<size_t> flat{ 1, 3, 5 };
+	std::bitset<8> bits{ 0b00101010 };
+
+	std::cout << fmt::format("added {} ", insertAndAssert(std::vector<size_t>{ 0, 1, 2, 3, 4 }, closure).added);
+	std::cout << fmt::format("{}\n", closure);
+	std::cout << fmt::format("added {} ", insertAndAssert(std::set<size_t>{ 6, 5, 0 }, flat).added);
+	std::cout << fmt::format("{}\n", flat);
+	std::cout << fmt::format("added {} without 7 ", insertAndAssert(std::set<size_t>{ 7, 8, 9 }, closure, 7).added);
+	std::cout << fmt::format("{}\n", closure);
+	std::cout << fmt::format("added {} ", insertAndAssert(std::bitset<8>{ 0b00001111 }, bits).added);
+	std::cout << fmt::format("{}\n", bits.to_string());
+	std::cout << fmt::format("added {} without 4 ", insertAndAssert(std::bitset<8>{ 0b11110000 }, bits, 4).added);
+	std::cout << fmt::format("{}\n", bits.to_string());
+	std::cout << fmt::format("added from {}: {}\n", flat, (bool)insertAndAssert(flat, closure));
+
+	// flat sets work with the same utilities as `std::set`
+	FlatSet<size_t, 4> small{ 3, 1, 2 };
+	FlatSet<size_t, 4> large{ 1, 2, 3 };
+
+	std::cout << fmt::format("{} (inline: {}) ", toString(small), small.isInline());
+	std::cout << fmt::format("added {} ", insertAndAssert(std::vector<size_t>{ 9, 8, 7, 6 }, large).added);
+	std::cout << fmt::format("{} (inline: {})\n", toString(large), large.isInline());
+	std::cout << fmt::format("8 {} {}; {} {} {}\n", in(isIn(8, large)), large, small, small == FlatSet<size_t, 4>{ 2, 3, 1 } ? "==" : "!=", FlatSet<size_t, 4>{ 2, 3, 1 });
+
+	// a transition table of flat sets: states 0 and 1 on 'a' and 'b'
+	std::vector<std::vector<FlatSet<size_t>>> transitions(2, std::vector<FlatSet<size_t>>(128));
+	transitions[0]['a'] = { 1 };
+	transitions[1]['b'] = { 0, 1 };
+	std::cout << toString(transitions, TABLE_STYLE::TS_CSV);
+
 	return 0;
 }
@@ -0,0 +1,304 @@
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "utility/Logger.h"
+#include "utility/BinaryLogger.h"
+#include "utility/LogSink.h"
+#include "utility/LoggerMetrics.h"
+#include "utility/SharedMemorySink.h"
+#include "testIncludes.h"
+
+using namespace m0st4fa;
+
+int loggerTests() {
+
+	Logger logger;
+
+	logger.log(LoggerInfo::LL_INFO, "Synchronous message.");
+
+	// Asynchronous mode: several producers, then an explicit flush
+	Logger::enableAsync({ .queueCapacity = 64, .batchSize = 16, .overflowPolicy = OVERFLOW_POLICY::OP_BLOCK });
+
+	std::vector<std::thread> producers;
+
+	for (size_t t = 0; t < 4; t++)
+		producers.emplace_back([t]() {
+		Logger logger;
+
+		for (size_t i = 0; i < 8; i++)
+			logger.log(LoggerInfo::LL_INFO, std::format("Asynchronous message {} from producer {}.", i, t));
+			});
+
+	for (std::thread& producer : producers)
+		producer.join();
+
+	Logger::flush();
+	std::cout << std::format("Dropped with OP_BLOCK: {}\n", Logger::droppedCount());
+
+	// A small queue that drops the newest records when it is full
+	Logger::enableAsync({ .queueCapacity = 2, .batchSize = 1, .overflowPolicy = OVERFLOW_POLICY::OP_DROP_NEWEST });
+
+	for (size_t i = 0; i < 64; i++)
+		logger.log(LoggerInfo::LL_WARNING, std::format("Possibly dropped message {}.", i));
+
+	Logger::flush();
+	std::cout << std::format("Dropped with OP_DROP_NEWEST: {}\n", Logger::droppedCount());
+
+	Logger::disableAsync();
+
+	return 0;
+}
+
+int lazyLoggerTests() {
+
+	Logger logger;
+
+	logger.log<LOG_LEVEL::LL_INFO>("Lazily formatted message: {} + {} = {}.", 1, 2, 1 + 2);
+
+	// below the runtime threshold, nothing is formatted
+	Logger::setLevel(LOG_LEVEL::LL_WARRNING);
+	logger.log<LOG_LEVEL::LL_INFO>("This message should not appear: {}.", std::string(64, 'x'));
+	logger.log<LOG_LEVEL::LL_WARRNING>("Threshold is {}; warnings still appear.", (int)Logger::getLevel());
+	Logger::setLevel(LOG_LEVEL::LL_DEBUG);
+
+	logger.log<LOG_LEVEL::LL_DEBUG>("Debug messages are compiled in: {}.", LOG_MIN_LEVEL == LOG_LEVEL::LL_DEBUG);
+
+	return 0;
+}
+
+int binaryLoggerTests() {
+
+	const std::string path = "binaryLoggerTests.ulog";
+
+	if (!BinaryLogger::open(path))
+		return 1;
+
+	for (int i = 0; i < 3; i++)
+		UTILITY_BINARY_LOG(LL_INFO, "Binary message {} of {}: {:.2f} ({})", i, 3, i * 0.5, std::string_view{ "deferred" });
+
+	UTILITY_BINARY_LOG(LL_ERROR, "A message without arguments.");
+
+	BinaryLogger::close();
+
+	std::ifstream input{ path, std::ios::binary };
+	BinaryLogDecoder decoder;
+	const size_t count = decoder.decode(input, std::cout);
+
+	std::cout << std::format("Decoded {} binary messages from {} callsites.\n", count, decoder.getCallsites().size());
+
+	input.close();
+	std::remove(path.c_str());
+
+	return 0;
+}
+
+int logSinkTests() {
+
+	Logger logger;
+
+	// fan out to an in-memory sink besides the console
+	auto memorySink = std::make_shared<MemorySink>();
+	Logger::addSink(memorySink);
+
+	logger.log(LoggerInfo::LL_WARNING, "Written to the console and to memory.");
+	logger.log<LOG_LEVEL::LL_ERROR>("Error number {}.", 42);
+
+	for (const LogRecord& record : memorySink->getRecords())
+		std::cout << std::format("MemorySink: {}", Logger::format(record, false));
+
+	// a small, size-rotated file sink replacing the console
+	const std::string path = "logSinkTests.log";
+	auto fileSink = std::make_shared<FileSink>(FileSinkOptions{ .path = path, .bufferSize = 64, .maxFileSize = 128, .maxBackups = 2, .append = false });
+	Logger::setSinks({ fileSink });
+
+	for (size_t i = 0; i < 10; i++)
+		logger.log<LOG_LEVEL::LL_INFO>("File message number {}.", i);
+
+	Logger::resetSinks();
+	fileSink.reset();
+
+	for (const std::string& name : { path, path + ".1", path + ".2" }) {
+		std::ifstream file{ name };
+		std::cout << std::format("{}:\n{}", name, std::string{ std::istreambuf_iterator<char>{file}, {} });
+		file.close();
+		std::remove(name.c_str());
+	}
+
+#ifdef __linux__
+	// every write to `/dev/full` fails with ENOSPC: the records are counted as dropped instead of throwing
+	auto fullSink = std::make_shared<FileSink>(FileSinkOptions{ .path = "/dev/full", .bufferSize = 64 });
+	Logger::setSinks({ fullSink });
+
+	for (size_t i = 0; i < 10; i++)
+		logger.log<LOG_LEVEL::LL_INFO>("Dropped message number {}.", i);
+
+	Logger::flush();
+	Logger::resetSinks();
+	std::cout << std::format("Failed writes: {}, dropped bytes: {}\n", fullSink->getFailedWrites(), fullSink->getDroppedBytes());
+#endif
+
+	return 0;
+}
+
+int rateLimiterTests() {
+
+	Logger logger;
+
+	// only 1 in 4 messages passes the sampling; a summary precedes each passing message
+	for (size_t i = 0; i < 10; i++)
+		logger.logLimited<LOG_LEVEL::LL_WARRNING>(RateLimit{ .everyN = 4 }, "Sampled message {}.", i);
+
+	// a burst of 3, refilled very slowly: the remaining messages are summarized by `flush`
+	for (size_t i = 0; i < 100; i++)
+		logger.log(LoggerInfo::LL_ERROR, std::format("Rate-limited message {}.", i), RateLimit{ .ratePerSecond = 0.001, .burst = 3 });
+
+	Logger::flush();
+
+	return 0;
+}
+
+int loggerMetricsTests() {
+
+	Logger logger;
+
+	LoggerMetrics::setEnabled(true);
+	Logger::setSinks({ std::make_shared<MemorySink>() });
+	Logger::enableAsync({ .queueCapacity = 16, .batchSize = 8, .overflowPolicy = OVERFLOW_POLICY::OP_DROP_OLDEST });
+
+	const LoggerMetricsSnapshot before = LoggerMetrics::getSnapshot();
+
+	for (size_t i = 0; i < 1000; i++)
+		logger.log<LOG_LEVEL::LL_INFO>("Measured message {}.", i);
+
+	logger.log<LOG_LEVEL::LL_ERROR>("Measured error.");
+
+	Logger::flush();
+
+	const LoggerMetricsSnapshot metrics = LoggerMetrics::getSnapshot() - before;
+
+	Logger::disableAsync();
+	Logger::resetSinks();
+	LoggerMetrics::setEnabled(false);
+
+	const size_t info = (size_t)LOG_LEVEL::LL_INFO;
+	std::cout << std::format("INFO messages written + dropped: {}\n", metrics.messages[info] + metrics.dropped[info]);
+	std::cout << toString(metrics) << "\n";
+
+	return 0;
+}
+
+static void logFromCallsites(size_t i) {
+	UTILITY_LOG(LL_WARRNING, "First callsite, iteration {}.", i);
+	UTILITY_LOG(LL_WARRNING, "Second callsite, iteration {}.", i);
+}
+
+int callsiteTests() {
+
+	logFromCallsites(0);
+
+	// switch the first callsite off, then the whole function
+	for (const Callsite* callsite : CallsiteRegistry::getCallsites())
+		if (std::string_view{ callsite->location.function_name() }.find("logFromCallsites") != std::string_view::npos) {
+			CallsiteRegistry::setEnabled(callsite->id, false);
+			break;
+		}
+
+	logFromCallsites(1);
+
+	std::cout << std::format("Switched off {} callsites.\n", CallsiteRegistry::setFunctionEnabled("logFromCallsites", false));
+	logFromCallsites(2);
+
+	CallsiteRegistry::setAllEnabled(true);
+	logFromCallsites(3);
+
+	return 0;
+}
+
+int flightRecorderTests() {
+
+	Logger logger;
+
+	FlightRecorder::setEnabled(true);
+
+	// from switched-off callsites, but recorded
+	CallsiteRegistry::setFunctionEnabled("logFromCallsites", false);
+	logFromCallsites(4);
+	CallsiteRegistry::setAllEnabled(true);
+
+	Logger::setLevel(LOG_LEVEL::LL_ERROR);
+
+	// discarded by the runtime threshold, but recorded (the debug detail in debug builds only, where `LL_DEBUG` is compiled in)
+	logger.log<LOG_LEVEL::LL_DEBUG>("Recorded debug detail {}.", 1);
+	logger.log(LoggerInfo::LL_INFO, "Recorded info detail.");
+
+	// suppressed by the rate limit, but recorded
+	for (size_t i = 0; i < 3; i++)
+		logger.logLimited<LOG_LEVEL::LL_ERROR>(RateLimit{ .everyN = 3 }, "Recorded limited detail {}.", i);
+
+	std::thread{ []() {
+		Logger{}.log<LOG_LEVEL::LL_WARRNING>("Recorded on another thread.");
+		} }.join();
+
+	// logging a fatal error dumps the recorder
+	logger.log(LoggerInfo::LL_FATAL_ERROR, "Fatal error.");
+
+	Logger::setLevel(LOG_LEVEL::LL_DEBUG);
+	FlightRecorder::clear();
+	FlightRecorder::setEnabled(false);
+
+	return 0;
+}
+
+int sharedMemorySinkTests() {
+
+#ifndef _WIN32
+	Logger logger;
+	const std::string name = "utility-sharedMemorySinkTests";
+
+	SharedLogRing::remove(name);
+
+	// the smallest ring: the messages below overflow it, and are dropped without blocking
+	auto sink = std::make_shared<SharedMemorySink>(SharedMemorySinkOptions{ .name = name, .capacity = 0 });
+	Logger::setSinks({ sink });
+
+	for (size_t i = 0; i < 100; i++)
+		logger.log<LOG_LEVEL::LL_INFO>("Shared message number {}.", i);
+
+	Logger::resetSinks();
+
+	std::vector<SharedLogEntry> entries;
+
+	// a collector that reads without committing leaves the records to the next one
+	{
+		SharedLogRing collector = SharedLogRing::open(name);
+		collector.read(entries);
+	}
+
+	SharedLogRing collector = SharedLogRing::open(name);
+	const size_t uncommitted = entries.size();
+
+	entries.clear();
+	collector.read(entries);
+	collector.commit();
+
+	std::cout << std::format("Read {} records, then {} again; {} dropped.\n", uncommitted, entries.size(), sink->droppedCount());
+	std::cout << std::format("First: {}", Logger::format(entries.front().record, false));
+	std::cout << std::format("Last: {}", Logger::format(entries.back().record, false));
+
+	// the ring has room again
+	entries.clear();
+	Logger::setSinks({ sink });
+	logger.log<LOG_LEVEL::LL_WARRNING>("Shared message after the collector caught up.");
+	Logger::resetSinks();
+
+	collector.read(entries);
+	collector.commit();
+	std::cout << std::format("Then: {}", Logger::format(entries.front().record, false));
+
+	SharedLogRing::remove(name);
+#endif
+
+	return 0;
+}
@@ -1,3 +1,14 @@
 
 int toStringTests();
 int iterableTests();
+int loggerTests();
+int lazyLoggerTests();
+int binaryLoggerTests();
+int logSinkTests();
+int rateLimiterTests();
+int loggerMetricsTests();
+int callsiteTests();
+int flightRecorderTests();
+int sharedMemorySinkTests();
+int traceTests();
+int integerTests();
@@ -5,6 +5,17 @@ int main() {
 
 	toStringTests();
 	iterableTests();
+	loggerTests();
+	lazyLoggerTests();
+	binaryLoggerTests();
+	logSinkTests();
+	rateLimiterTests();
+	loggerMetricsTests();
+	callsiteTests();
+	flightRecorderTests();
+	sharedMemorySinkTests();
+	traceTests();
+	integerTests();
 
 	return 0;
 }
@@ -1,5 +1,10 @@
 #include <string>
+#include <climits>
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
 #include "utility/common.h"
+#include "utility/ParallelFormat.h"
 #include "testIncludes.h"
 
 int toStringTests() {
@@ -8,5 +13,84 @@ int toStringTests() {
 
 	std::cout << fmt::format("Displaying the set of the first 6 positive integers: {}\n", m0st4fa::utility::toString(someInts));
 
+	// the result is allocated once, at its estimated size
+	std::vector<double> someDoubles{ -1.5, 0.25, 99.999999 };
+	const std::string doubles = m0st4fa::utility::toString(someDoubles);
+
+	std::cout << fmt::format("Displaying some doubles: {} (estimated {} characters, got {})\n", doubles, m0st4fa::utility::estimateToStringSize(someDoubles), doubles.size());
+
+	std::map<char, std::vector<int>> someMap{ { 'a', { 1, 2 } }, { 'b', {} } };
+	std::cout << fmt::format("Displaying a map:\n{}", m0st4fa::utility::toString(someMap));
+
+	// streaming: the same output, written as it is formatted
+	std::string streamed;
+	m0st4fa::utility::formatTo(std::back_inserter(streamed), someInts);
+	std::cout << fmt::format("Streamed to a string: {} (identical: {})\n", streamed, streamed == m0st4fa::utility::toString(someInts));
+
+	std::cout << "Streamed from a view: ";
+	m0st4fa::utility::formatTo(std::cout, std::views::iota(1, 7) | std::views::transform([](int i) { return i * i; }));
+	std::cout << std::endl;
+
+	{
+		m0st4fa::utility::FdWriter writer{ 1, 16 };
+
+		writer.append("Streamed to a file descriptor in chunks of 16 characters:\n");
+		m0st4fa::utility::formatTo(writer, someMap);
+		writer.flush();
+	}
+
+	// numbers written straight into a buffer
+	m0st4fa::utility::StringBuilder numbers;
+
+	for (const long long number : { 0LL, 7LL, -42LL, 1234567890123LL, LLONG_MIN }) {
+		m0st4fa::utility::appendNumber(numbers, number);
+		numbers.append(' ');
+	}
+
+	m0st4fa::utility::appendNumber(numbers, 0.1);
+	numbers.append(' ');
+	m0st4fa::utility::appendNumber(numbers, 1e300);
+	numbers.append(' ');
+	m0st4fa::utility::appendFixed(numbers, 2.0 / 3.0);
+	std::cout << fmt::format("Appended numbers: {}\n", numbers.view());
+
+	// parallel: identical output, formatted in chunks on several threads
+	std::vector<int> manyInts(100'000);
+
+	for (size_t i = 0; i < manyInts.size(); i++)
+		manyInts[i] = (int)i;
+
+	const m0st4fa::utility::ParallelFormatOptions options{ .threadCount = 4, .serialThreshold = 1'000, .minChunkSize = 1'000 };
+	std::cout << fmt::format("Formatted in parallel: identical: {}\n", m0st4fa::utility::toStringParallel(manyInts, true, options) == m0st4fa::utility::toString(manyInts));
+
+	// strings allocated from a request-scoped arena, released in bulk
+	{
+		char arena[1024];
+		std::pmr::monotonic_buffer_resource resource{ arena, sizeof(arena), std::pmr::null_memory_resource() };
+
+		const std::pmr::string ints = m0st4fa::utility::toString(someInts, &resource);
+		const std::pmr::string map = m0st4fa::utility::toString(someMap, &resource);
+		std::cout << fmt::format("Allocated from an arena: {} and\n{}", ints, map);
+	}
+
+	// tables rendered in two passes into a single allocation
+	const std::vector<std::vector<std::string>> table{ { "name", "value" }, { "pi", "3.14" }, { "quoted \"x, y\"", "a|b" } };
+
+	for (const auto style : { m0st4fa::utility::TABLE_STYLE::TS_BOX, m0st4fa::utility::TABLE_STYLE::TS_PLAIN, m0st4fa::utility::TABLE_STYLE::TS_CSV, m0st4fa::utility::TABLE_STYLE::TS_MARKDOWN })
+		std::cout << m0st4fa::utility::renderTable(table, style) << "\n";
+
+	// a transition table: states 0 to 2 on 'a' and 'b'
+	std::vector<std::vector<std::vector<size_t>>> transitions(3, std::vector<std::vector<size_t>>(128));
+	transitions[0]['a'] = { 1 };
+	transitions[0]['b'] = { 2 };
+	transitions[1]['b'] = { 2 };
+	const auto getNonEmptyColumns = [](const std::vector<std::vector<std::vector<size_t>>>&) { return std::set<size_t>{ 'a', 'b' }; };
+	std::cout << m0st4fa::utility::toString<std::vector<size_t>>(transitions, getNonEmptyColumns, m0st4fa::utility::TABLE_STYLE::TS_BOX) << "\n";
+
+	// the occupied columns, found by the library itself
+	const m0st4fa::utility::ColumnOccupancyIndex index{ transitions };
+	std::cout << fmt::format("Occupied columns: {} (state 1: {})\n", m0st4fa::utility::toString(index.getOccupiedColumns()), index.isOccupied(1, 'a') ? "a, b" : "b");
+	std::cout << m0st4fa::utility::toString(transitions, m0st4fa::utility::TABLE_STYLE::TS_PLAIN) << "\n";
+
 	return 0;
 }
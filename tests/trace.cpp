@@ -0,0 +1,52 @@
+#define UTILITY_ENABLE_TRACING
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "utility/Trace.h"
+#include "testIncludes.h"
+
+using namespace m0st4fa;
+
+static void traceFunction() {
+	UTILITY_TRACE_FUNCTION();
+
+	for (int i = 0; i < 3; i++) {
+		UTILITY_TRACE_SCOPE("iteration");
+	}
+}
+
+int traceTests() {
+
+	TraceTicks elapsed{};
+
+	{
+		ScopedTimer timer{ elapsed };
+		UTILITY_TRACE_SCOPE("outer");
+
+		traceFunction();
+
+		std::thread{ []() {
+			UTILITY_TRACE_SCOPE(std::string{ "worker " } + "thread");
+			} }.join();
+	}
+
+	// spans are not recorded while tracing is disabled at runtime
+	Tracer::setEnabled(false);
+	traceFunction();
+	Tracer::setEnabled(true);
+
+	std::ostringstream json;
+	const size_t count = Tracer::exportChromeTrace(json);
+
+	std::cout << "Recorded " << count << " spans in " << (elapsed.toNanoseconds().count() > 0 ? "a positive" : "no") << " time.\n";
+	const std::string text = json.str();
+
+	std::cout << "Exported " << std::ranges::count(text, '\n') << " lines, starting with " << text.substr(0, text.find('\n')) << "\n";
+
+	Tracer::clear();
+
+	return 0;
+}
@@ -0,0 +1,142 @@
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "utility/SharedMemorySink.h"
+
+using namespace m0st4fa;
+
+namespace {
+
+	volatile std::sig_atomic_t s_Stop = 0;
+
+	void stop(int) {
+		s_Stop = 1;
+	}
+
+	struct Producer {
+		std::string name;
+		std::optional<SharedLogRing> ring{};
+		uint64_t dropped = 0;
+		bool missing = false;
+	};
+
+}
+
+/**
+ * @brief Writes out the records that processes log through `SharedMemorySink`s.
+ * @details Usage: utility-logcollector [--color] [--timestamps] [--once] [--interval <ms>] [--output <file>] <ring name>...
+ * Rings that do not exist yet are opened as soon as their producer creates them. Records are released to the producers only once they are written out, so a collector that is restarted picks up where the last one stopped. With `--once`, the rings are drained once and the collector exits; otherwise, it runs until interrupted.
+ */
+int main(int argc, char* argv[]) {
+	bool color = false;
+	bool timestamps = false;
+	bool once = false;
+	std::chrono::milliseconds interval{ 10 };
+	const char* outputPath = nullptr;
+	std::vector<Producer> producers;
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+
+		if (!std::strcmp(arg, "--color"))
+			color = true;
+		else if (!std::strcmp(arg, "--timestamps"))
+			timestamps = true;
+		else if (!std::strcmp(arg, "--once"))
+			once = true;
+		else if (!std::strcmp(arg, "--interval") && i + 1 < argc)
+			interval = std::chrono::milliseconds{ std::atoi(argv[++i]) };
+		else if (!std::strcmp(arg, "--output") && i + 1 < argc)
+			outputPath = argv[++i];
+		else
+			producers.push_back({ arg });
+	}
+
+	if (producers.empty()) {
+		std::cerr << "Usage: utility-logcollector [--color] [--timestamps] [--once] [--interval <ms>] [--output <file>] <ring name>...\n";
+		return 1;
+	}
+
+	std::ofstream outputFile;
+
+	if (outputPath) {
+		outputFile.open(outputPath, std::ios::binary | std::ios::app);
+
+		if (!outputFile) {
+			std::cerr << "Could not open `" << outputPath << "`.\n";
+			return 1;
+		}
+	}
+
+	std::ostream& out = outputPath ? outputFile : std::cout;
+
+	std::signal(SIGINT, stop);
+	std::signal(SIGTERM, stop);
+
+	std::vector<SharedLogEntry> entries;
+	int status = 0;
+
+	// after a stop is requested, drain one last time
+	for (bool stopping = false; ; stopping = s_Stop || once) {
+		size_t count = 0;
+
+		for (Producer& producer : producers) {
+			if (producer.missing)
+				continue;
+
+			try {
+				if (!producer.ring)
+					producer.ring = SharedLogRing::open(producer.name);
+
+				entries.clear();
+				count += producer.ring->read(entries, 4096);
+
+				for (const SharedLogEntry& entry : entries) {
+					if (timestamps)
+						out << fmt::format("{}.{:09} ", entry.timestamp / 1'000'000'000, entry.timestamp % 1'000'000'000);
+
+					out << Logger::format(entry.record, color);
+				}
+
+				out.flush();
+
+				// the records are released only once they have been written out
+				if (!out) {
+					std::cerr << "Could not write out the records of `" << producer.name << "`.\n";
+					return 1;
+				}
+
+				producer.ring->commit();
+
+				if (const uint64_t dropped = producer.ring->droppedCount(); dropped != producer.dropped) {
+					std::cerr << "`" << producer.name << "` dropped " << dropped - producer.dropped << " records.\n";
+					producer.dropped = dropped;
+				}
+			}
+			catch (const LogSinkError& error) {
+				// a ring that does not exist yet is retried, unless draining once
+				if (!once && !producer.ring)
+					continue;
+
+				std::cerr << error.msg << "\n";
+				producer.missing = !producer.ring;
+				status = 1;
+			}
+		}
+
+		if (stopping && !count)
+			break;
+
+		if (!count && !s_Stop)
+			std::this_thread::sleep_for(interval);
+	}
+
+	return status;
+}
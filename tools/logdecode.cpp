@@ -0,0 +1,72 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "utility/BinaryLogger.h"
+
+using namespace m0st4fa;
+
+static constexpr const char* USAGE = "Usage: utility-logdecode [--color] [--timestamps] [--locations] <binary log> [output file]\n";
+
+/**
+ * @brief Decodes a binary log written by `BinaryLogger` into text.
+ * @details Usage: utility-logdecode [--color] [--timestamps] [--locations] <binary log> [output file]
+ */
+int main(int argc, char* argv[]) {
+	BinaryLogDecoderOptions options;
+	const char* inputPath = nullptr;
+	const char* outputPath = nullptr;
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+
+		if (!std::strcmp(arg, "--color"))
+			options.color = true;
+		else if (!std::strcmp(arg, "--timestamps"))
+			options.timestamps = true;
+		else if (!std::strcmp(arg, "--locations"))
+			options.locations = true;
+		else if (!inputPath)
+			inputPath = arg;
+		else if (!outputPath)
+			outputPath = arg;
+		else {
+			std::cerr << USAGE;
+			return 1;
+		}
+	}
+
+	if (!inputPath) {
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	std::ifstream input{ inputPath, std::ios::binary };
+
+	if (!input) {
+		std::cerr << "Could not open `" << inputPath << "`.\n";
+		return 1;
+	}
+
+	std::ofstream outputFile;
+
+	if (outputPath) {
+		outputFile.open(outputPath, std::ios::binary);
+
+		if (!outputFile) {
+			std::cerr << "Could not open `" << outputPath << "`.\n";
+			return 1;
+		}
+	}
+
+	try {
+		BinaryLogDecoder decoder;
+		decoder.decode(input, outputPath ? outputFile : std::cout, options);
+	}
+	catch (const utility::ConversionError& error) {
+		std::cerr << error.msg << "\n";
+		return 1;
+	}
+
+	return 0;
+}